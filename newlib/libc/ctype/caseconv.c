@@ -10,6 +10,21 @@ Modified (m) 2017 Thomas Wolff: revise Unicode and locale/wchar handling
 #include <langinfo.h>
 #include "local.h"
 
+#ifdef __WCTYPE_STAGES
+
+#include "caseconv_stages.h"
+
+const struct caseconv_delta *
+__caseconv_delta (wint_t ucs, locale_t locale)
+{
+  if (ucs >= 0x110000 || (ucs >= 0x80 && __locale_is_C(locale)))
+    return &caseconv_stage_delta[0];
+
+  return &caseconv_stage_delta[CASECONV_INDEX(ucs)];
+}
+
+#else
+
 static const struct caseconv_entry table [] = {
 #include "caseconv.t"
 };
@@ -42,3 +57,5 @@ __caseconv_lookup (wint_t ucs, locale_t locale)
     }
   return 0;
 }
+
+#endif /* __WCTYPE_STAGES */
@@ -41,6 +41,36 @@
 
 #ifdef __MB_CAPABLE
 
+#ifdef __WCTYPE_STAGES
+
+#include "ctype_stages.h"
+
+uint16_t
+__ctype_table_lookup(wint_t ic, locale_t locale)
+{
+    wchar_t     c;
+
+    /* ASCII classes are the same in every locale */
+    if (ic < 0x80)
+        return ctype_stage_class[CTYPE_INDEX(ic)];
+
+    if (ic == WEOF)
+        return CLASS_none;
+
+    c = (wchar_t) ic;
+
+    /* Be compatible with glibc where the C locale has no classes outside of ASCII */
+    if (__locale_is_C(locale))
+        return CLASS_none;
+
+    if ((wint_t) c >= 0x110000)
+        return CLASS_none;
+
+    return ctype_stage_class[CTYPE_INDEX((wint_t) c)];
+}
+
+#else
+
 static const struct {
     wchar_t             code;
     uint16_t            category;
@@ -80,4 +110,6 @@ __ctype_table_lookup(wint_t ic, locale_t locale)
     }
     return ctype_table[high].category;
 }
+
+#endif /* __WCTYPE_STAGES */
 #endif /* __MB_CAPABLE */
@@ -138,3 +138,19 @@ __attribute__((packed))
 
 const struct caseconv_entry *
 __caseconv_lookup(wint_t c, locale_t locale);
+
+#ifdef __WCTYPE_STAGES
+/*
+   With __WCTYPE_STAGES set, case conversion uses a multi-stage table
+   indexed by code point instead (see mkctype-stages.py). Each entry
+   holds the offsets added by towlower and towupper.
+ */
+struct caseconv_delta
+{
+  int_least32_t lower;
+  int_least32_t upper;
+};
+
+const struct caseconv_delta *
+__caseconv_delta(wint_t c, locale_t locale);
+#endif
@@ -0,0 +1,236 @@
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Copyright © 2026 Keith Packard
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above
+#    copyright notice, this list of conditions and the following
+#    disclaimer in the documentation and/or other materials provided
+#    with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+# INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+# STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+# OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+'''
+Build multi-stage lookup tables for the wide character class and case
+conversion data. The tables are derived from the interval tables in
+ctype_table.h (generated by mkctype.py) and caseconv.t (generated by
+mkcaseconv) so that every lookup method returns the same answers.
+
+Usage: mkctype-stages.py ctype > ctype_stages.h
+       mkctype-stages.py caseconv > caseconv_stages.h
+'''
+
+import os
+import re
+import sys
+
+MAX_CODE = 0x110000
+
+here = os.path.dirname(os.path.abspath(__file__))
+
+def load_ctype():
+    '''Class expression for each code point from ctype_table.h'''
+    entries = []
+    skip = False
+    with open(os.path.join(here, 'ctype_table.h')) as f:
+        for line in f:
+            # Use the full table, not the 16-bit wchar_t one
+            if line.startswith('#if __SIZEOF_WCHAR_T__ == 2'):
+                skip = True
+            elif line.startswith('#else'):
+                skip = False
+            elif not skip:
+                m = re.match(r'\{ 0x([0-9a-f]+), ([A-Za-z_|]+) \},', line)
+                if m:
+                    entries.append((int(m.group(1), 16), m.group(2)))
+    values = []
+    e = 0
+    for code in range(MAX_CODE):
+        while e + 1 < len(entries) and entries[e+1][0] <= code:
+            e += 1
+        values.append(entries[e][1])
+    return values
+
+def load_caseconv():
+    '''(towlower, towupper) offsets for each code point from caseconv.t'''
+    values = [(0, 0)] * MAX_CODE
+    with open(os.path.join(here, 'caseconv.t')) as f:
+        for line in f:
+            m = re.match(r'\s*\{(0x[0-9A-Fa-f]+), (\d+), (\w+), ([-\w]+)\},', line)
+            if not m:
+                continue
+            first = int(m.group(1), 16)
+            diff = int(m.group(2))
+            mode = m.group(3)
+            delta = m.group(4)
+            for code in range(first, first + diff + 1):
+                lower, upper = 0, 0
+                if mode == 'TOLO':
+                    lower = int(delta)
+                elif mode == 'TOUP':
+                    upper = int(delta)
+                elif mode == 'TOBOTH':
+                    lower, upper = 1, -1
+                elif mode == 'TO1':
+                    capital = (code & 1) == (0 if delta == 'EVENCAP' else 1)
+                    if capital:
+                        lower = 1
+                    else:
+                        upper = -1
+                values[code] = (lower, upper)
+    return values
+
+def dedup(values, size):
+    '''Split values into blocks of size, returning (index, blocks)'''
+    blocks = {}
+    index = []
+    for i in range(0, len(values), size):
+        block = tuple(values[i:i+size])
+        if block not in blocks:
+            blocks[block] = len(blocks)
+        index.append(blocks[block])
+    return index, list(blocks)
+
+def int_type(count):
+    return 'uint8_t' if count <= 256 else 'uint16_t'
+
+def type_size(count):
+    return 1 if count <= 256 else 2
+
+def two_stage(values):
+    '''Pick the block size giving the smallest two-stage table'''
+    best = None
+    for bits in range(4, 11):
+        index, blocks = dedup(values, 1 << bits)
+        size = len(index) * type_size(len(blocks)) + len(blocks) * (1 << bits)
+        if not best or size < best[0]:
+            best = (size, bits, index, blocks)
+    return best
+
+def three_stage(values):
+    '''Pick the block sizes giving the smallest three-stage table'''
+    best = None
+    for bits in range(3, 9):
+        mid, blocks = dedup(values, 1 << bits)
+        for bits1 in range(2, 9):
+            index, mids = dedup(mid, 1 << bits1)
+            size = (len(index) * type_size(len(mids)) +
+                    len(mids) * (1 << bits1) * type_size(len(blocks)) +
+                    len(blocks) * (1 << bits))
+            if not best or size < best[0]:
+                best = (size, bits, bits1, index, mids, blocks)
+    return best
+
+def dump_array(name, ctype, rows):
+    print('static const %s %s[%d] = {' % (ctype, name, len(rows)))
+    for i in range(0, len(rows), 16):
+        print('    ' + ' '.join('%d,' % v for v in rows[i:i+16]))
+    print('};')
+
+def dump_blocks(name, ctype, blocks):
+    print('static const %s %s[%d][%d] = {' % (ctype, name, len(blocks), len(blocks[0])))
+    for block in blocks:
+        print('    {')
+        for i in range(0, len(block), 16):
+            print('        ' + ' '.join('%d,' % v for v in block[i:i+16]))
+        print('    },')
+    print('};')
+
+def dump_stages(prefix, keys):
+    '''Emit both table layouts for the per-code index into the value table'''
+    two = two_stage(keys)
+    three = three_stage(keys)
+    print()
+    print('#if __WCTYPE_STAGES == 2')
+    print()
+    print('/* %d bytes */' % two[0])
+    print('#define %s_SHIFT %d' % (prefix.upper(), two[1]))
+    dump_array(prefix + '_stage1', int_type(len(two[3])), two[2])
+    dump_blocks(prefix + '_stage2', 'uint8_t', two[3])
+    print()
+    print('#define %s_INDEX(c) %s_stage2[%s_stage1[(c) >> %s_SHIFT]][(c) & ((1 << %s_SHIFT) - 1)]' %
+          (prefix.upper(), prefix, prefix, prefix.upper(), prefix.upper()))
+    print()
+    print('#else')
+    print()
+    print('/* %d bytes */' % three[0])
+    print('#define %s_SHIFT %d' % (prefix.upper(), three[1]))
+    print('#define %s_SHIFT1 %d' % (prefix.upper(), three[2]))
+    dump_array(prefix + '_stage1', int_type(len(three[4])), three[3])
+    dump_blocks(prefix + '_stage2', int_type(len(three[5])), three[4])
+    dump_blocks(prefix + '_stage3', 'uint8_t', three[5])
+    print()
+    P = prefix.upper()
+    print('#define %s_INDEX(c) %s_stage3[%s_stage2[%s_stage1[(c) >> (%s_SHIFT + %s_SHIFT1)]]'
+          '[((c) >> %s_SHIFT) & ((1 << %s_SHIFT1) - 1)]][(c) & ((1 << %s_SHIFT) - 1)]' %
+          (P, prefix, prefix, prefix, P, P, P, P, P))
+    print()
+    print('#endif')
+
+def header():
+    '''License from ctype_table.h, with the copyright of this script'''
+    with open(os.path.join(here, 'ctype_table.h')) as f:
+        for line in f:
+            if line.startswith(' * Copyright'):
+                line = ' * Copyright © 2026 Keith Packard\n'
+            print(line, end='')
+            if line.startswith(' */'):
+                break
+    print()
+    print('/* This file is auto-generated from mkctype-stages.py */')
+
+def dump_ctype():
+    values = load_ctype()
+    classes = sorted(set(values), key=lambda c: (c != 'CLASS_none', c))
+    number = {c: i for i, c in enumerate(classes)}
+    header()
+    print()
+    print('static const uint16_t ctype_stage_class[%d] = {' % len(classes))
+    for c in classes:
+        print('    %s,' % c)
+    print('};')
+    dump_stages('ctype', [number[v] for v in values])
+
+def dump_caseconv():
+    values = load_caseconv()
+    deltas = sorted(set(values), key=lambda d: (d != (0, 0), d))
+    number = {d: i for i, d in enumerate(deltas)}
+    header()
+    print()
+    print('static const struct caseconv_delta caseconv_stage_delta[%d] = {' % len(deltas))
+    for d in deltas:
+        print('    { %d, %d },' % d)
+    print('};')
+    dump_stages('caseconv', [number[v] for v in values])
+
+if len(sys.argv) != 2 or sys.argv[1] not in ('ctype', 'caseconv'):
+    print('usage: %s ctype|caseconv' % sys.argv[0], file=sys.stderr)
+    sys.exit(1)
+
+if sys.argv[1] == 'ctype':
+    dump_ctype()
+else:
+    dump_caseconv()
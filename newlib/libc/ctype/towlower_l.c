@@ -11,6 +11,13 @@ wint_t
 towlower_l (wint_t c, locale_t locale)
 {
 #ifdef __MB_CAPABLE
+  /* ASCII case mapping is the same in every locale */
+  if (c < 0x80)
+    return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+
+#ifdef __WCTYPE_STAGES
+  return c + __caseconv_delta(c, locale)->lower;
+#else
   const struct caseconv_entry * cce = __caseconv_lookup(c, locale);
 
   if (cce)
@@ -39,6 +46,7 @@ towlower_l (wint_t c, locale_t locale)
       }
 
   return c;
+#endif
 #else
   (void) locale;
   return towlower(c);
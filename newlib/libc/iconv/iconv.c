@@ -71,6 +71,17 @@ iconv (iconv_t ic,
                 ic->buf_off = ic->buf_len = 0;
             }
         } else if (inbytes && ic->buf_len == 0) {
+#ifdef ICONV_FAST
+            /* convert as much as possible in bulk, then one char here */
+            if (ic->fast && outbytes >= MB_LEN_MAX &&
+                ic->in_state.__count == 0 && ic->out_state.__count == 0)
+            {
+                char *was = in;
+                ic->fast(&in, &inbytes, &out, &outbytes);
+                if (in != was)
+                    continue;
+            }
+#endif
             ret = ic->in_mbtowc(&wc, in, inbytes, &ic->in_state);
             switch (ret) {
             case 0:
@@ -0,0 +1,403 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "iconv_private.h"
+
+#ifdef ICONV_FAST
+
+#include <stdint.h>
+#include <endian.h>
+#include "../string/local.h"
+
+/*
+ * Bulk converters for common charset pairs. Each one converts
+ * characters directly, without going through a wchar_t and a pair of
+ * indirect calls, and stops at anything it cannot convert exactly as
+ * in_mbtowc/out_wctomb would: NUL bytes, invalid or truncated input,
+ * surrogates, characters the output charset can't represent and the
+ * last MB_LEN_MAX bytes of output. iconv then converts the next
+ * character with the generic code, so results and error positions
+ * don't change.
+ */
+
+enum iconv_enc {
+    ENC_ASCII,
+    ENC_LATIN1,
+    ENC_UTF8,
+    ENC_UCS2,
+    ENC_UCS2SWAP,
+    ENC_UCS4,
+    ENC_UCS4SWAP,
+};
+
+#if _BYTE_ORDER == _LITTLE_ENDIAN
+#define ENC_UCS2LE      ENC_UCS2
+#define ENC_UCS2BE      ENC_UCS2SWAP
+#define ENC_UCS4LE      ENC_UCS4
+#define ENC_UCS4BE      ENC_UCS4SWAP
+#else
+#define ENC_UCS2LE      ENC_UCS2SWAP
+#define ENC_UCS2BE      ENC_UCS2
+#define ENC_UCS4LE      ENC_UCS4SWAP
+#define ENC_UCS4BE      ENC_UCS4
+#endif
+
+#define HIGH_BITS       ((~0UL / 0xff) * 0x80)
+
+/* Is c a byte in 0x01-0x7f? */
+#define IS_ASCII(c)     ((unsigned) (c) - 1U < 0x7fU)
+
+/* Is c in the range of wchar_t, as the generic converters require? */
+#define IS_WCHAR(c)     ((c) <= 0x10ffff && (c) <= (uint32_t) WCHAR_MAX)
+
+#define IS_SURROGATE(c) (0xd800 <= (c) && (c) <= 0xdfff)
+
+/*
+ * Count the leading bytes in 0x01-0x7f, a word at a time
+ */
+static size_t
+ascii_run(const unsigned char *s, size_t n)
+{
+    const unsigned char *p = s;
+    const unsigned char *e = s + n;
+    unsigned long       w;
+
+    while (p < e && UNALIGNED_X(p)) {
+        if (!IS_ASCII(*p))
+            return p - s;
+        p++;
+    }
+    while ((size_t) (e - p) >= LITTLE_BLOCK_SIZE) {
+        w = *(const unsigned long *) p;
+        if ((w & HIGH_BITS) || DETECT_NULL(w))
+            break;
+        p += LITTLE_BLOCK_SIZE;
+    }
+    while (p < e && IS_ASCII(*p))
+        p++;
+    return p - s;
+}
+
+/*
+ * Decode one character, returning its length or 0 to leave it to
+ * the generic code.
+ */
+static __always_inline int
+decode(enum iconv_enc from, const unsigned char *s, size_t n, uint32_t *pc)
+{
+    uint32_t    c;
+    uint16_t    u16;
+    uint32_t    u32;
+
+    switch (from) {
+    case ENC_ASCII:
+        if (!IS_ASCII(s[0]))
+            return 0;
+        *pc = s[0];
+        return 1;
+    case ENC_LATIN1:
+        if (s[0] == 0)
+            return 0;
+        *pc = s[0];
+        return 1;
+    case ENC_UTF8:
+        c = s[0];
+        if (c < 0x80) {
+            if (c == 0)
+                return 0;
+            *pc = c;
+            return 1;
+        }
+        if (c >= 0xc2 && c <= 0xdf) {
+            if (n < 2 || (s[1] & 0xc0) != 0x80)
+                return 0;
+            *pc = ((c & 0x1f) << 6) | (s[1] & 0x3f);
+            return 2;
+        }
+        if (c >= 0xe0 && c <= 0xef) {
+            if (n < 3 || (s[1] & 0xc0) != 0x80 || (s[2] & 0xc0) != 0x80 ||
+                (c == 0xe0 && s[1] < 0xa0))
+                return 0;
+            c = ((c & 0x0f) << 12) | ((uint32_t) (s[1] & 0x3f) << 6) | (s[2] & 0x3f);
+            if (IS_SURROGATE(c))
+                return 0;
+            *pc = c;
+            return 3;
+        }
+#if __SIZEOF_WCHAR_T__ > 2
+        if (c >= 0xf0 && c <= 0xf4) {
+            if (n < 4 || (s[1] & 0xc0) != 0x80 || (s[2] & 0xc0) != 0x80 ||
+                (s[3] & 0xc0) != 0x80 || (c == 0xf0 && s[1] < 0x90) ||
+                (c == 0xf4 && s[1] >= 0x90))
+                return 0;
+            *pc = ((c & 0x07) << 18) | ((uint32_t) (s[1] & 0x3f) << 12) |
+                ((uint32_t) (s[2] & 0x3f) << 6) | (s[3] & 0x3f);
+            return 4;
+        }
+#endif
+        return 0;
+    case ENC_UCS2:
+    case ENC_UCS2SWAP:
+        if (n < 2)
+            return 0;
+        memcpy(&u16, s, 2);
+        if (from == ENC_UCS2SWAP)
+            u16 = __bswap16(u16);
+        *pc = u16;
+        return 2;
+    case ENC_UCS4:
+    case ENC_UCS4SWAP:
+        if (n < 4)
+            return 0;
+        memcpy(&u32, s, 4);
+        if (from == ENC_UCS4SWAP)
+            u32 = __bswap32(u32);
+        if (!IS_WCHAR(u32))
+            return 0;
+        *pc = u32;
+        return 4;
+    }
+    return 0;
+}
+
+/*
+ * Encode one character, returning its length or 0 to leave it to
+ * the generic code.
+ */
+static __always_inline int
+encode(enum iconv_enc to, unsigned char *s, uint32_t c)
+{
+    uint16_t    u16;
+    uint32_t    u32;
+
+    switch (to) {
+    case ENC_ASCII:
+        if (c >= 0x80)
+            return 0;
+        s[0] = c;
+        return 1;
+    case ENC_LATIN1:
+        if (c >= 0x100)
+            return 0;
+        s[0] = c;
+        return 1;
+    case ENC_UTF8:
+        if (c < 0x80) {
+            s[0] = c;
+            return 1;
+        }
+        if (c < 0x800) {
+            s[0] = 0xc0 | (c >> 6);
+            s[1] = 0x80 | (c & 0x3f);
+            return 2;
+        }
+        if (c < 0x10000) {
+            if (IS_SURROGATE(c))
+                return 0;
+            s[0] = 0xe0 | (c >> 12);
+            s[1] = 0x80 | ((c >> 6) & 0x3f);
+            s[2] = 0x80 | (c & 0x3f);
+            return 3;
+        }
+        s[0] = 0xf0 | (c >> 18);
+        s[1] = 0x80 | ((c >> 12) & 0x3f);
+        s[2] = 0x80 | ((c >> 6) & 0x3f);
+        s[3] = 0x80 | (c & 0x3f);
+        return 4;
+    case ENC_UCS2:
+    case ENC_UCS2SWAP:
+        if (c >= 0x10000 || IS_SURROGATE(c))
+            return 0;
+        u16 = c;
+        if (to == ENC_UCS2SWAP)
+            u16 = __bswap16(u16);
+        memcpy(s, &u16, 2);
+        return 2;
+    case ENC_UCS4:
+    case ENC_UCS4SWAP:
+        if (IS_SURROGATE(c))
+            return 0;
+        u32 = c;
+        if (to == ENC_UCS4SWAP)
+            u32 = __bswap32(u32);
+        memcpy(s, &u32, 4);
+        return 4;
+    }
+    return 0;
+}
+
+static __always_inline void
+convert(enum iconv_enc from, enum iconv_enc to,
+        char **inbuf, size_t *inbytesleft,
+        char **outbuf, size_t *outbytesleft)
+{
+    const unsigned char *in = (const unsigned char *) *inbuf;
+    unsigned char       *out = (unsigned char *) *outbuf;
+    size_t              inbytes = *inbytesleft;
+    size_t              outbytes = *outbytesleft;
+    size_t              run, room, i;
+    uint32_t            c;
+    int                 inlen, outlen;
+    bool                bytes_in = from == ENC_ASCII || from == ENC_LATIN1 || from == ENC_UTF8;
+    bool                bytes_out = to == ENC_ASCII || to == ENC_LATIN1 || to == ENC_UTF8;
+
+    while (inbytes && outbytes >= MB_LEN_MAX) {
+        /* ASCII maps to itself in all of these */
+        if (bytes_in && IS_ASCII(in[0])) {
+            run = ascii_run(in, inbytes);
+            if (bytes_out) {
+                room = outbytes - (MB_LEN_MAX - 1);
+                if (run > room)
+                    run = room;
+                memcpy(out, in, run);
+                out += run;
+                outbytes -= run;
+            } else {
+                for (i = 0; i < run && outbytes >= MB_LEN_MAX; i++) {
+                    outlen = encode(to, out, in[i]);
+                    out += outlen;
+                    outbytes -= outlen;
+                }
+                run = i;
+            }
+            in += run;
+            inbytes -= run;
+            continue;
+        }
+        inlen = decode(from, in, inbytes, &c);
+        if (!inlen)
+            break;
+        outlen = encode(to, out, c);
+        if (!outlen)
+            break;
+        in += inlen;
+        inbytes -= inlen;
+        out += outlen;
+        outbytes -= outlen;
+    }
+    *inbuf = (char *) in;
+    *inbytesleft = inbytes;
+    *outbuf = (char *) out;
+    *outbytesleft = outbytes;
+}
+
+#define CONVERTER(name, from, to)                                       \
+    static void                                                         \
+    name(char **inbuf, size_t *inbytesleft,                             \
+         char **outbuf, size_t *outbytesleft)                           \
+    {                                                                   \
+        convert(from, to, inbuf, inbytesleft, outbuf, outbytesleft);    \
+    }
+
+CONVERTER(utf8_utf8, ENC_UTF8, ENC_UTF8)
+CONVERTER(utf8_ascii, ENC_UTF8, ENC_ASCII)
+CONVERTER(ascii_utf8, ENC_ASCII, ENC_UTF8)
+#ifdef __MB_EXTENDED_CHARSETS_UCS
+CONVERTER(utf8_ucs2, ENC_UTF8, ENC_UCS2)
+CONVERTER(utf8_ucs2swap, ENC_UTF8, ENC_UCS2SWAP)
+CONVERTER(utf8_ucs4, ENC_UTF8, ENC_UCS4)
+CONVERTER(utf8_ucs4swap, ENC_UTF8, ENC_UCS4SWAP)
+CONVERTER(ucs2_utf8, ENC_UCS2, ENC_UTF8)
+CONVERTER(ucs2swap_utf8, ENC_UCS2SWAP, ENC_UTF8)
+CONVERTER(ucs4_utf8, ENC_UCS4, ENC_UTF8)
+CONVERTER(ucs4swap_utf8, ENC_UCS4SWAP, ENC_UTF8)
+#endif
+#ifdef __MB_EXTENDED_CHARSETS_ISO
+CONVERTER(utf8_latin1, ENC_UTF8, ENC_LATIN1)
+CONVERTER(latin1_utf8, ENC_LATIN1, ENC_UTF8)
+#endif
+
+#if _BYTE_ORDER == _LITTLE_ENDIAN
+#define utf8_ucs2le     utf8_ucs2
+#define utf8_ucs2be     utf8_ucs2swap
+#define utf8_ucs4le     utf8_ucs4
+#define utf8_ucs4be     utf8_ucs4swap
+#define ucs2le_utf8     ucs2_utf8
+#define ucs2be_utf8     ucs2swap_utf8
+#define ucs4le_utf8     ucs4_utf8
+#define ucs4be_utf8     ucs4swap_utf8
+#else
+#define utf8_ucs2le     utf8_ucs2swap
+#define utf8_ucs2be     utf8_ucs2
+#define utf8_ucs4le     utf8_ucs4swap
+#define utf8_ucs4be     utf8_ucs4
+#define ucs2le_utf8     ucs2swap_utf8
+#define ucs2be_utf8     ucs2_utf8
+#define ucs4le_utf8     ucs4swap_utf8
+#define ucs4be_utf8     ucs4_utf8
+#endif
+
+static const struct {
+    unsigned char       from;
+    unsigned char       to;
+    iconv_fast_p        fast;
+} iconv_fast_pairs[] = {
+    { locale_UTF_8, locale_UTF_8, utf8_utf8 },
+    { locale_UTF_8, locale_C, utf8_ascii },
+    { locale_C, locale_UTF_8, ascii_utf8 },
+#ifdef __MB_EXTENDED_CHARSETS_UCS
+    { locale_UTF_8, locale_UCS_2, utf8_ucs2 },
+    { locale_UTF_8, locale_UCS_2LE, utf8_ucs2le },
+    { locale_UTF_8, locale_UCS_2BE, utf8_ucs2be },
+    { locale_UTF_8, locale_UCS_4, utf8_ucs4 },
+    { locale_UTF_8, locale_UCS_4LE, utf8_ucs4le },
+    { locale_UTF_8, locale_UCS_4BE, utf8_ucs4be },
+    { locale_UCS_2, locale_UTF_8, ucs2_utf8 },
+    { locale_UCS_2LE, locale_UTF_8, ucs2le_utf8 },
+    { locale_UCS_2BE, locale_UTF_8, ucs2be_utf8 },
+    { locale_UCS_4, locale_UTF_8, ucs4_utf8 },
+    { locale_UCS_4LE, locale_UTF_8, ucs4le_utf8 },
+    { locale_UCS_4BE, locale_UTF_8, ucs4be_utf8 },
+#endif
+#ifdef __MB_EXTENDED_CHARSETS_ISO
+    { locale_UTF_8, locale_ISO_8859_1, utf8_latin1 },
+    { locale_ISO_8859_1, locale_UTF_8, latin1_utf8 },
+#endif
+};
+
+#define NUM_FAST_PAIRS  (sizeof(iconv_fast_pairs) / sizeof(iconv_fast_pairs[0]))
+
+iconv_fast_p
+__iconv_fast(enum locale_id fromid, enum locale_id toid)
+{
+    size_t      i;
+
+    for (i = 0; i < NUM_FAST_PAIRS; i++)
+        if (iconv_fast_pairs[i].from == fromid && iconv_fast_pairs[i].to == toid)
+            return iconv_fast_pairs[i].fast;
+    return NULL;
+}
+
+#endif /* ICONV_FAST */
@@ -57,6 +57,9 @@ iconv_open (const char *tocode, const char *fromcode)
 
     ic->in_mbtowc = __get_mbtowc(fromid);
     ic->out_wctomb = __get_wctomb(toid);
+#ifdef ICONV_FAST
+    ic->fast = __iconv_fast(fromid, toid);
+#endif
     return ic;
 #else
     return NULL;
@@ -40,9 +40,20 @@
 #include "../ctype/ctype_.h"
 #include <iconv.h>
 
+#if defined(__MB_CAPABLE) && !defined(__PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+#define ICONV_FAST
+#endif
+
+typedef void iconv_fast_f(char **inbuf, size_t *inbytesleft,
+                          char **outbuf, size_t *outbytesleft);
+typedef iconv_fast_f *iconv_fast_p;
+
 struct __iconv_t {
     mbtowc_p    in_mbtowc;
     wctomb_p    out_wctomb;
+#ifdef ICONV_FAST
+    iconv_fast_p fast;
+#endif
     mbstate_t   in_state;
     mbstate_t   out_state;
     char        buf[MB_LEN_MAX];
@@ -50,4 +61,9 @@ struct __iconv_t {
     size_t      buf_off;
 };
 
+#ifdef ICONV_FAST
+iconv_fast_p
+__iconv_fast(enum locale_id fromid, enum locale_id toid);
+#endif
+
 #endif /* _ICONV_PRIVATE_H_ */
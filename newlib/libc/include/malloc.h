@@ -82,6 +82,9 @@ void *pvalloc (size_t);
 int malloc_trim (size_t);
 void __malloc_lock(void);
 void __malloc_unlock(void);
+#ifdef __NANO_MALLOC_TCACHE
+void __malloc_tcache_flush(void);
+#endif
 
 /* SVID2/XPG mallopt options */
 
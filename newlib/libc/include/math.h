@@ -36,6 +36,7 @@ SUCH DAMAGE.
 #define  _MATH_H_
 
 #include <sys/cdefs.h>
+#include <sys/_types.h>
 
 _BEGIN_STD_C
 
@@ -489,9 +490,28 @@ extern double hypot (double, double);
 
 /* Single precision versions of ANSI functions.  */
 
+/*
+ * sinf, cosf, expf, logf and powf also have variants for the x86_64
+ * and AArch64 vector function ABIs (_ZGVbN4v_sinf, _ZGVnN4v_sinf and
+ * the like). Advertise them so the compiler can vectorize loops
+ * calling these functions; variants for SVE are not provided.
+ */
+#if !defined(_LIBC) && !__OBSOLETE_MATH_FLOAT && \
+    ((defined(__x86_64__) && defined(__SSE2__)) || \
+     (defined(__aarch64__) && defined(__ARM_NEON) && !defined(__ARM_FEATURE_SVE)))
+# if __GNUC_PREREQ (9, 0) && !defined(__clang__)
+#  define __declare_simd __attribute__((__simd__ ("notinbranch")))
+# elif defined(__clang__) && defined(_OPENMP)
+#  define __declare_simd _Pragma ("omp declare simd notinbranch")
+# endif
+#endif
+#ifndef __declare_simd
+# define __declare_simd
+#endif
+
 extern float atanf (float);
-extern float cosf (float);
-extern float sinf (float);
+__declare_simd extern float cosf (float);
+__declare_simd extern float sinf (float);
 extern float tanf (float);
 extern float tanhf (float);
 extern float frexpf (float, int *);
@@ -505,11 +525,11 @@ extern float asinf (float);
 extern float atan2f (float, float);
 extern float coshf (float);
 extern float sinhf (float);
-extern float expf (float);
+__declare_simd extern float expf (float);
 extern float ldexpf (float, int);
-extern float logf (float);
+__declare_simd extern float logf (float);
 extern float log10f (float);
-extern float powf (float, float);
+__declare_simd extern float powf (float, float);
 extern float sqrtf (float);
 extern float fmodf (float, float);
 
@@ -689,6 +709,24 @@ extern long double pow10l (long double);
 #endif
 #endif /* __GNU_VISIBLE */
 
+/* Array versions, out[i] = f(in[i]) for 0 <= i < n. out may equal in. */
+extern void __vexp (double *, const double *, __size_t);
+extern void __vexp2 (double *, const double *, __size_t);
+extern void __vlog (double *, const double *, __size_t);
+extern void __vsin (double *, const double *, __size_t);
+extern void __vcos (double *, const double *, __size_t);
+extern void __vsincos (double *, double *, const double *, __size_t);
+extern void __vpow (double *, const double *, const double *, __size_t);
+extern void __vtanh (double *, const double *, __size_t);
+extern void __vexpf (float *, const float *, __size_t);
+extern void __vexp2f (float *, const float *, __size_t);
+extern void __vlogf (float *, const float *, __size_t);
+extern void __vsinf (float *, const float *, __size_t);
+extern void __vcosf (float *, const float *, __size_t);
+extern void __vsincosf (float *, float *, const float *, __size_t);
+extern void __vpowf (float *, const float *, const float *, __size_t);
+extern void __vtanhf (float *, const float *, __size_t);
+
 #if __MISC_VISIBLE || __XSI_VISIBLE
 extern int signgam;
 #endif /* __MISC_VISIBLE || __XSI_VISIBLE */
@@ -0,0 +1,236 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _PICOLIBC_BENCH_H_
+#define _PICOLIBC_BENCH_H_
+
+#include <sys/cdefs.h>
+#include <stdint.h>
+
+/*
+ * Low-overhead timer for measuring code in place. Uses the processor
+ * cycle or timer counter where one can be read without help:
+ *
+ *      x86             rdtsc
+ *      aarch64         cntvct_el0
+ *      riscv           rdcycle (rdtime on Linux, which hides the
+ *                      cycle counter from user mode)
+ *
+ * Elsewhere, this uses semihosting SYS_ELAPSED/SYS_TICKFREQ when
+ * <semihost.h> is available, dropping to SYS_CLOCK if the host lacks
+ * those, and otherwise clock(). Define PICOLIBC_BENCH_SEMIHOST or
+ * PICOLIBC_BENCH_CLOCK to force one of those. PICOLIBC_BENCH_COUNTER
+ * is defined when a hardware counter is in use.
+ *
+ *      struct bench_timer t;
+ *      bench_start(&t);
+ *      ... code to measure ...
+ *      bench_stop(&t);
+ *      cycles = bench_elapsed(&t);
+ *
+ * bench_elapsed subtracts the cost of the start/stop pair itself,
+ * measured once on first use.
+ */
+
+#if !defined(PICOLIBC_BENCH_SEMIHOST) && !defined(PICOLIBC_BENCH_CLOCK)
+#if defined(__x86_64__) || defined(__i386__)
+#define __BENCH_RDTSC
+#elif defined(__aarch64__)
+#define __BENCH_CNTVCT
+#elif defined(__riscv)
+#define __BENCH_RDCYCLE
+#elif defined(__has_include)
+#if __has_include(<semihost.h>)
+#define PICOLIBC_BENCH_SEMIHOST
+#endif
+#endif
+#if !defined(__BENCH_RDTSC) && !defined(__BENCH_CNTVCT) && \
+    !defined(__BENCH_RDCYCLE) && !defined(PICOLIBC_BENCH_SEMIHOST)
+#define PICOLIBC_BENCH_CLOCK
+#endif
+#endif
+
+#if defined(__BENCH_RDTSC) || defined(__BENCH_CNTVCT) || defined(__BENCH_RDCYCLE)
+#define PICOLIBC_BENCH_COUNTER
+#endif
+
+#ifdef PICOLIBC_BENCH_SEMIHOST
+#include <semihost.h>
+#endif
+#ifdef PICOLIBC_BENCH_CLOCK
+#include <time.h>
+#endif
+
+_BEGIN_STD_C
+
+struct bench_timer {
+    uint64_t    start;
+    uint64_t    stop;
+};
+
+#ifdef PICOLIBC_BENCH_SEMIHOST
+/*
+ * The SYS_ELAPSED rate, or 100 when the host does not support
+ * SYS_ELAPSED and the centisecond SYS_CLOCK is used instead.
+ */
+static __inline uintptr_t
+__bench_semihost_freq(void)
+{
+    static uintptr_t freq;
+
+    if (!freq) {
+        freq = sys_semihost_tickfreq();
+        if (freq == 0 || freq == (uintptr_t) -1)
+            freq = 100;
+    }
+    return freq;
+}
+#endif
+
+/* Read the raw counter */
+static __inline uint64_t
+bench_cycles(void)
+{
+#if defined(__BENCH_RDTSC)
+    uint32_t lo, hi;
+#ifdef __SSE2__
+    /* Keep earlier instructions from drifting past the read */
+    __asm__ volatile ("lfence\n\trdtsc" : "=a" (lo), "=d" (hi) : : "memory");
+#else
+    __asm__ volatile ("rdtsc" : "=a" (lo), "=d" (hi) : : "memory");
+#endif
+    return ((uint64_t) hi << 32) | lo;
+#elif defined(__BENCH_CNTVCT)
+    uint64_t v;
+    __asm__ volatile ("isb\n\tmrs %0, cntvct_el0" : "=r" (v) : : "memory");
+    return v;
+#elif defined(__BENCH_RDCYCLE)
+#ifdef __linux__
+#define __BENCH_CSR "time"
+#else
+#define __BENCH_CSR "cycle"
+#endif
+#if __riscv_xlen == 32
+    uint32_t lo, hi, hi2;
+    do {
+        __asm__ volatile ("rd" __BENCH_CSR "h %0" : "=r" (hi) : : "memory");
+        __asm__ volatile ("rd" __BENCH_CSR " %0" : "=r" (lo) : : "memory");
+        __asm__ volatile ("rd" __BENCH_CSR "h %0" : "=r" (hi2) : : "memory");
+    } while (hi != hi2);
+    return ((uint64_t) hi << 32) | lo;
+#else
+    uint64_t v;
+    __asm__ volatile ("rd" __BENCH_CSR " %0" : "=r" (v) : : "memory");
+    return v;
+#endif
+#undef __BENCH_CSR
+#elif defined(PICOLIBC_BENCH_SEMIHOST)
+    if (__bench_semihost_freq() == 100)
+        return sys_semihost_clock();
+    return sys_semihost_elapsed();
+#else
+    return (uint64_t) clock();
+#endif
+}
+
+/*
+ * Counter ticks per second, or zero when the counter runs at an
+ * unknown rate (the x86 TSC and the riscv cycle counter).
+ */
+static __inline uint64_t
+bench_cycles_per_sec(void)
+{
+#if defined(__BENCH_CNTVCT)
+    uint64_t freq;
+    __asm__ volatile ("mrs %0, cntfrq_el0" : "=r" (freq));
+    return freq;
+#elif defined(__BENCH_RDCYCLE) || defined(__BENCH_RDTSC)
+    return 0;
+#elif defined(PICOLIBC_BENCH_SEMIHOST)
+    return __bench_semihost_freq();
+#else
+    return CLOCKS_PER_SEC;
+#endif
+}
+
+static __inline void
+bench_start(struct bench_timer *t)
+{
+    t->start = bench_cycles();
+}
+
+static __inline void
+bench_stop(struct bench_timer *t)
+{
+    t->stop = bench_cycles();
+}
+
+/*
+ * Cost of an empty start/stop pair. The minimum over several tries
+ * discards samples disturbed by interrupts or cache misses.
+ */
+static __inline uint64_t
+bench_overhead(void)
+{
+    static uint64_t overhead = (uint64_t) -1;
+    struct bench_timer t;
+    int i;
+
+    if (overhead == (uint64_t) -1) {
+        uint64_t min = (uint64_t) -1;
+        for (i = 0; i < 64; i++) {
+            bench_start(&t);
+            bench_stop(&t);
+            if (t.stop - t.start < min)
+                min = t.stop - t.start;
+        }
+        overhead = min;
+    }
+    return overhead;
+}
+
+/* Ticks between start and stop, less the timer's own overhead */
+static __inline uint64_t
+bench_elapsed(const struct bench_timer *t)
+{
+    uint64_t elapsed = t->stop - t->start;
+    uint64_t overhead = bench_overhead();
+
+    return elapsed > overhead ? elapsed - overhead : 0;
+}
+
+_END_STD_C
+
+#endif /* _PICOLIBC_BENCH_H_ */
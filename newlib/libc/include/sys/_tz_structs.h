@@ -12,11 +12,35 @@ typedef struct __tzrule_struct
   long offset; /* Match type of _timezone. */
 } __tzrule_type;
 
+/*
+ * Number of years for which the DST change-over times are kept, so
+ * that converting times from a few different years does not recompute
+ * them on every call.
+ */
+#ifndef __TZ_YEAR_CACHE
+#ifdef __PREFER_SIZE_OVER_SPEED
+#define __TZ_YEAR_CACHE 0
+#else
+#define __TZ_YEAR_CACHE 4
+#endif
+#endif
+
+typedef struct __tzyear_struct
+{
+  int year; /* 0 if unused */
+  int north;
+  time_t change[2];
+} __tzyear_type;
+
 typedef struct __tzinfo_struct
 {
   int __tznorth;
   int __tzyear;
   __tzrule_type __tzrule[2];
+#if __TZ_YEAR_CACHE > 0
+  int __tzcache_next;
+  __tzyear_type __tzcache[__TZ_YEAR_CACHE];
+#endif
 } __tzinfo_type;
 
 __tzinfo_type *__gettzinfo (void);
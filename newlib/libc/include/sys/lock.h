@@ -16,6 +16,8 @@
 #define __lock_close_recursive(lock) ((void) 0)
 #define __lock_acquire(lock) ((void) 0)
 #define __lock_acquire_recursive(lock) ((void) 0)
+#define __lock_try_acquire(lock) 0
+#define __lock_try_acquire_recursive(lock) 0
 #define __lock_release(lock) ((void) 0)
 #define __lock_release_recursive(lock) ((void) 0)
 
@@ -37,6 +39,8 @@ void __retarget_lock_close(_LOCK_T lock);
 void __retarget_lock_close_recursive(_LOCK_T lock);
 void __retarget_lock_acquire(_LOCK_T lock);
 void __retarget_lock_acquire_recursive(_LOCK_T lock);
+int __retarget_lock_try_acquire(_LOCK_T lock);
+int __retarget_lock_try_acquire_recursive(_LOCK_T lock);
 void __retarget_lock_release(_LOCK_T lock);
 void __retarget_lock_release_recursive(_LOCK_T lock);
 
@@ -46,6 +50,8 @@ void __retarget_lock_release_recursive(_LOCK_T lock);
 #define __lock_close_recursive(lock) __retarget_lock_close_recursive(lock)
 #define __lock_acquire(lock) __retarget_lock_acquire(lock)
 #define __lock_acquire_recursive(lock) __retarget_lock_acquire_recursive(lock)
+#define __lock_try_acquire(lock) __retarget_lock_try_acquire(lock)
+#define __lock_try_acquire_recursive(lock) __retarget_lock_try_acquire_recursive(lock)
 #define __lock_release(lock) __retarget_lock_release(lock)
 #define __lock_release_recursive(lock) __retarget_lock_release_recursive(lock)
 
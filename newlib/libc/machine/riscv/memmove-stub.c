@@ -11,6 +11,7 @@
 
 #include <picolibc.h>
 
-#if !defined(__PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+#if !defined(__riscv_vector) && \
+    !defined(__PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
 #include "../../string/memmove.c"
 #endif
@@ -15,6 +15,8 @@
 #include <stdint.h>
 #include "rv_string.h"
 
+/* With the V extension, strlen comes from strlen-rvv.S */
+#ifndef __riscv_vector
 size_t strlen(const char *str)
 {
   const char *start = str;
@@ -55,3 +57,4 @@ size_t strlen(const char *str)
     return str - start;
 #endif /* not PREFER_SIZE_OVER_SPEED */
 }
+#endif /* __riscv_vector */
@@ -47,6 +47,11 @@ is preserved.
 #define r14 REG(r14)
 #define r15 REG(r15)
 
+#define r8d  REG(r8d)
+#define r9d  REG(r9d)
+#define r10d REG(r10d)
+#define r11d REG(r11d)
+
 #define eax REG(eax)
 #define ebx REG(ebx)
 #define ecx REG(ecx)
@@ -99,6 +104,15 @@ is preserved.
 #define xmm6 REG(xmm6)
 #define xmm7 REG(xmm7)
 
+#define ymm0 REG(ymm0)
+#define ymm1 REG(ymm1)
+#define ymm2 REG(ymm2)
+#define ymm3 REG(ymm3)
+#define ymm4 REG(ymm4)
+#define ymm5 REG(ymm5)
+#define ymm6 REG(ymm6)
+#define ymm7 REG(ymm7)
+
 #define cr0 REG(cr0)
 #define cr1 REG(cr1)
 #define cr2 REG(cr2)
@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Vector helpers for the x86_64 string functions. The same sources
+ * build with SSE2 (16 byte vectors) or, when the compiler targets
+ * AVX2, with 32 byte vectors. Two-operand macros follow the SSE
+ * convention where the second operand is both source and destination.
+ */
+
+#ifndef _X86_64VEC_H_
+#define _X86_64VEC_H_
+
+#include "x86_64mach.h"
+
+#ifdef __AVX2__
+
+#define VEC_SIZE        32
+#define VEC_MASK_ALL    0xffffffff
+
+#define V0      ymm0
+#define V1      ymm1
+#define V2      ymm2
+#define V3      ymm3
+
+#define VMOVU(s, d)             vmovdqu s, d
+#define VMOVA(s, d)             vmovdqa s, d
+#define VPCMPEQB(s, d)          vpcmpeqb s, d, d
+#define VPCMPEQB3(s, a, d)      vpcmpeqb s, a, d
+#define VPMINUB(s, d)           vpminub s, d, d
+#define VPOR(s, d)              vpor s, d, d
+#define VPMOVMSKB(v, r)         vpmovmskb v, r
+#define VZERO(v)                vpxor v, v, v
+#define VBROADCASTB(r, n)       vmovd r, xmm##n; vpbroadcastb xmm##n, ymm##n
+#define VZEROUPPER              vzeroupper
+
+#else
+
+#define VEC_SIZE        16
+#define VEC_MASK_ALL    0xffff
+
+#define V0      xmm0
+#define V1      xmm1
+#define V2      xmm2
+#define V3      xmm3
+
+#define VMOVU(s, d)             movdqu s, d
+#define VMOVA(s, d)             movdqa s, d
+#define VPCMPEQB(s, d)          pcmpeqb s, d
+#define VPCMPEQB3(s, a, d)      movdqa a, d; pcmpeqb s, d
+#define VPMINUB(s, d)           pminub s, d
+#define VPOR(s, d)              por s, d
+#define VPMOVMSKB(v, r)         pmovmskb v, r
+#define VZERO(v)                pxor v, v
+#define VBROADCASTB(r, n)       movd r, xmm##n; punpcklbw xmm##n, xmm##n; \
+                                punpcklwd xmm##n, xmm##n; pshufd $0, xmm##n, xmm##n
+#define VZEROUPPER
+
+#endif
+
+/* Loads of VEC_SIZE bytes starting at most this far into a page stay in the page */
+#define VEC_PAGE_LIMIT  (4096 - VEC_SIZE)
+
+#define ENTRY(name)                     \
+        .text;                          \
+        .p2align 4;                     \
+        .global SYM (name);             \
+        SOTYPE_FUNCTION(name);          \
+SYM (name):
+
+#endif /* _X86_64VEC_H_ */
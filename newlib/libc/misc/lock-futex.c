@@ -0,0 +1,355 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * __retarget_lock functions for programs running on Linux.
+ *
+ * A lock is a futex word holding 0 when unlocked, 1 when locked and 2
+ * when locked with threads waiting. Taking a free lock and releasing
+ * one nobody waits for are single atomic operations; contended
+ * acquires spin briefly before sleeping in FUTEX_WAIT. Recursive
+ * locks record the owning thread by its thread pointer.
+ */
+
+#include <sys/lock.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifndef __SINGLE_THREAD
+
+#define FUTEX_WAIT_PRIVATE	128
+#define FUTEX_WAKE_PRIVATE	129
+
+/* How many times to poll a held lock before sleeping */
+#ifndef LOCK_SPIN
+#define LOCK_SPIN		100
+#endif
+
+struct __lock {
+  atomic_int state;
+  _Atomic uintptr_t owner;
+  unsigned count;
+};
+
+struct __lock __lock___libc_recursive_mutex;
+
+#if defined(__x86_64__)
+
+static inline long
+futex (atomic_int *uaddr, int op, int val)
+{
+  register long r10 __asm__("r10") = 0;
+  long ret;
+
+  __asm__ volatile ("syscall"
+		    : "=a" (ret)
+		    : "0" (202L), "D" (uaddr), "S" ((long) op), "d" ((long) val), "r" (r10)
+		    : "rcx", "r11", "memory");
+  return ret;
+}
+
+static inline uintptr_t
+thread_self (void)
+{
+  uintptr_t tp;
+
+  __asm__ ("mov %%fs:0, %0" : "=r" (tp));
+  return tp;
+}
+
+#define cpu_relax()	__asm__ volatile ("pause" ::: "memory")
+
+#elif defined(__i386__)
+
+static inline long
+futex (atomic_int *uaddr, int op, int val)
+{
+  long ret;
+
+  __asm__ volatile ("int $0x80"
+		    : "=a" (ret)
+		    : "0" (240L), "b" (uaddr), "c" (op), "d" (val), "S" (0)
+		    : "memory");
+  return ret;
+}
+
+static inline uintptr_t
+thread_self (void)
+{
+  uintptr_t tp;
+
+  __asm__ ("mov %%gs:0, %0" : "=r" (tp));
+  return tp;
+}
+
+#define cpu_relax()	__asm__ volatile ("pause" ::: "memory")
+
+#elif defined(__aarch64__)
+
+static inline long
+futex (atomic_int *uaddr, int op, int val)
+{
+  register long x8 __asm__("x8") = 98;
+  register long x0 __asm__("x0") = (long) uaddr;
+  register long x1 __asm__("x1") = op;
+  register long x2 __asm__("x2") = val;
+  register long x3 __asm__("x3") = 0;
+
+  __asm__ volatile ("svc 0"
+		    : "+r" (x0)
+		    : "r" (x8), "r" (x1), "r" (x2), "r" (x3)
+		    : "memory");
+  return x0;
+}
+
+static inline uintptr_t
+thread_self (void)
+{
+  uintptr_t tp;
+
+  __asm__ ("mrs %0, tpidr_el0" : "=r" (tp));
+  return tp;
+}
+
+#define cpu_relax()	__asm__ volatile ("yield" ::: "memory")
+
+#elif defined(__arm__)
+
+static inline long
+futex (atomic_int *uaddr, int op, int val)
+{
+  register long r7 __asm__("r7") = 240;
+  register long r0 __asm__("r0") = (long) uaddr;
+  register long r1 __asm__("r1") = op;
+  register long r2 __asm__("r2") = val;
+  register long r3 __asm__("r3") = 0;
+
+  __asm__ volatile ("svc 0"
+		    : "+r" (r0)
+		    : "r" (r7), "r" (r1), "r" (r2), "r" (r3)
+		    : "memory");
+  return r0;
+}
+
+static inline uintptr_t
+thread_self (void)
+{
+  uintptr_t tp;
+
+  __asm__ ("mrc p15, 0, %0, c13, c0, 3" : "=r" (tp));
+  return tp;
+}
+
+#define cpu_relax()	__asm__ volatile ("" ::: "memory")
+
+#elif defined(__riscv)
+
+static inline long
+futex (atomic_int *uaddr, int op, int val)
+{
+  /* rv32 only has futex_time64, which is the same without a timeout */
+  register long a7 __asm__("a7") = __riscv_xlen == 32 ? 422 : 98;
+  register long a0 __asm__("a0") = (long) uaddr;
+  register long a1 __asm__("a1") = op;
+  register long a2 __asm__("a2") = val;
+  register long a3 __asm__("a3") = 0;
+
+  __asm__ volatile ("ecall"
+		    : "+r" (a0)
+		    : "r" (a7), "r" (a1), "r" (a2), "r" (a3)
+		    : "memory");
+  return a0;
+}
+
+static inline uintptr_t
+thread_self (void)
+{
+  uintptr_t tp;
+
+  __asm__ ("mv %0, tp" : "=r" (tp));
+  return tp;
+}
+
+#define cpu_relax()	__asm__ volatile ("" ::: "memory")
+
+#else
+#error futex locks are not supported on this architecture
+#endif
+
+static void
+futex_lock (struct __lock *lock)
+{
+  int c = 0;
+  int spin;
+
+  if (atomic_compare_exchange_strong_explicit (&lock->state, &c, 1,
+					       memory_order_acquire,
+					       memory_order_relaxed))
+    return;
+
+  /* The holder may be about to release it; don't sleep right away */
+  for (spin = 0; spin < LOCK_SPIN && c != 2; spin++)
+    {
+      cpu_relax ();
+      c = atomic_load_explicit (&lock->state, memory_order_relaxed);
+      if (c == 0 &&
+	  atomic_compare_exchange_weak_explicit (&lock->state, &c, 1,
+						 memory_order_acquire,
+						 memory_order_relaxed))
+	return;
+    }
+
+  /* Mark the lock contended so the holder wakes us on release */
+  c = atomic_exchange_explicit (&lock->state, 2, memory_order_acquire);
+  while (c != 0)
+    {
+      futex (&lock->state, FUTEX_WAIT_PRIVATE, 2);
+      c = atomic_exchange_explicit (&lock->state, 2, memory_order_acquire);
+    }
+}
+
+static int
+futex_try_lock (struct __lock *lock)
+{
+  int c = 0;
+
+  return !atomic_compare_exchange_strong_explicit (&lock->state, &c, 1,
+						   memory_order_acquire,
+						   memory_order_relaxed);
+}
+
+static void
+futex_unlock (struct __lock *lock)
+{
+  if (atomic_exchange_explicit (&lock->state, 0, memory_order_release) == 2)
+    futex (&lock->state, FUTEX_WAKE_PRIVATE, 1);
+}
+
+/*
+ * Dynamic locks are allocated. If that fails the lock is left NULL
+ * and operations on it do nothing, as with the default stubs.
+ */
+void
+__retarget_lock_init (_LOCK_T *lock)
+{
+  *lock = calloc (1, sizeof (struct __lock));
+}
+
+void
+__retarget_lock_init_recursive (_LOCK_T *lock)
+{
+  __retarget_lock_init (lock);
+}
+
+void
+__retarget_lock_close (_LOCK_T lock)
+{
+  free (lock);
+}
+
+void
+__retarget_lock_close_recursive (_LOCK_T lock)
+{
+  free (lock);
+}
+
+void
+__retarget_lock_acquire (_LOCK_T lock)
+{
+  if (lock)
+    futex_lock (lock);
+}
+
+int
+__retarget_lock_try_acquire (_LOCK_T lock)
+{
+  return lock ? futex_try_lock (lock) : 0;
+}
+
+void
+__retarget_lock_release (_LOCK_T lock)
+{
+  if (lock)
+    futex_unlock (lock);
+}
+
+void
+__retarget_lock_acquire_recursive (_LOCK_T lock)
+{
+  uintptr_t self = thread_self ();
+
+  if (!lock)
+    return;
+  /* Only this thread can have stored its own id here */
+  if (atomic_load_explicit (&lock->owner, memory_order_relaxed) == self)
+    {
+      lock->count++;
+      return;
+    }
+  futex_lock (lock);
+  atomic_store_explicit (&lock->owner, self, memory_order_relaxed);
+  lock->count = 1;
+}
+
+int
+__retarget_lock_try_acquire_recursive (_LOCK_T lock)
+{
+  uintptr_t self = thread_self ();
+
+  if (!lock)
+    return 0;
+  if (atomic_load_explicit (&lock->owner, memory_order_relaxed) == self)
+    {
+      lock->count++;
+      return 0;
+    }
+  if (futex_try_lock (lock))
+    return 1;
+  atomic_store_explicit (&lock->owner, self, memory_order_relaxed);
+  lock->count = 1;
+  return 0;
+}
+
+void
+__retarget_lock_release_recursive (_LOCK_T lock)
+{
+  if (!lock || --lock->count)
+    return;
+  atomic_store_explicit (&lock->owner, 0, memory_order_relaxed);
+  futex_unlock (lock);
+}
+
+#endif /* __SINGLE_THREAD */
@@ -1,7 +1,7 @@
 /* Copyright (c) 2016 Thomas Preud'homme <thomas.preudhomme@arm.com> */
 /*
 FUNCTION
-<<__retarget_lock_init>>, <<__retarget_lock_init_recursive>>, <<__retarget_lock_close>>, <<__retarget_lock_close_recursive>>, <<__retarget_lock_acquire>>, <<__retarget_lock_acquire_recursive>>, <<__retarget_lock_release>>, <<__retarget_lock_release_recursive>>---locking routines
+<<__retarget_lock_init>>, <<__retarget_lock_init_recursive>>, <<__retarget_lock_close>>, <<__retarget_lock_close_recursive>>, <<__retarget_lock_acquire>>, <<__retarget_lock_acquire_recursive>>, <<__retarget_lock_try_acquire>>, <<__retarget_lock_try_acquire_recursive>>, <<__retarget_lock_release>>, <<__retarget_lock_release_recursive>>---locking routines
 
 INDEX
 	__lock___sfp_recursive_mutex
@@ -30,6 +30,10 @@ INDEX
 	__retarget_lock_acquire
 INDEX
 	__retarget_lock_acquire_recursive
+INDEX
+	__retarget_lock_try_acquire
+INDEX
+	__retarget_lock_try_acquire_recursive
 INDEX
 	__retarget_lock_release
 INDEX
@@ -51,6 +55,8 @@ SYNOPSIS
 	void __retarget_lock_close_recursive (_LOCK_T <[lock]>);
 	void __retarget_lock_acquire (_LOCK_T <[lock]>);
 	void __retarget_lock_acquire_recursive (_LOCK_T <[lock]>);
+	int __retarget_lock_try_acquire (_LOCK_T <[lock]>);
+	int __retarget_lock_try_acquire_recursive (_LOCK_T <[lock]>);
 	void __retarget_lock_release (_LOCK_T <[lock]>);
 	void __retarget_lock_release_recursive (_LOCK_T <[lock]>);
 
@@ -66,6 +72,12 @@ an implementation for @strong{all} these routines and static locks.  If some
 routines or static locks are missing, the link will fail with doubly defined
 symbols.
 
+The try_acquire routines return 0 when they acquired the lock and non-zero
+when it is held by another thread; they never block.
+
+On Linux targets, picolibc can instead be built with the futex-locks option,
+which supplies these routines using the futex system call.
+
 PORTABILITY
 These locking routines and static lock are newlib-specific.  Supporting OS
 subroutines are required for linking multi-threaded applications.
@@ -119,6 +131,20 @@ __retarget_lock_acquire_recursive (_LOCK_T lock)
   (void) lock;
 }
 
+int
+__retarget_lock_try_acquire (_LOCK_T lock)
+{
+  (void) lock;
+  return 0;
+}
+
+int
+__retarget_lock_try_acquire_recursive (_LOCK_T lock)
+{
+  (void) lock;
+  return 0;
+}
+
 void
 __retarget_lock_release (_LOCK_T lock)
 {
@@ -51,6 +51,7 @@
 #define	print	sprint
 #define	at	sat
 #define	match	smat
+#define	dfast	sdfast
 #endif
 #ifdef LNAMES
 #define	matcher	lmatcher
@@ -62,6 +63,7 @@
 #define	print	lprint
 #define	at	lat
 #define	match	lmat
+#define	dfast	ldfast
 #endif
 
 /* another structure passed up and down to avoid zillions of parameters */
@@ -90,6 +92,10 @@ static char *backref(struct match *m, char *start, char *stop, sopno startst, so
 static char *fast(struct match *m, char *start, char *stop, sopno startst, sopno stopst);
 static char *slow(struct match *m, char *start, char *stop, sopno startst, sopno stopst);
 static states step(struct re_guts *g, sopno start, sopno stop, states bef, int ch, states aft);
+static char *skipfirst(struct re_guts *g, char *beginp, char *p, char *stop);
+#ifdef __REGEX_DFA_STATES
+static int dfast(struct match *m, char *start, char *stop, sopno startst, sopno stopst, char **endp);
+#endif
 #define	BOL	(OUT+1)
 #define	EOL	(BOL+1)
 #define	BOLEOL	(BOL+2)
@@ -140,6 +146,7 @@ matcher(
 	struct match mv;
 	struct match *m = &mv;
 	char *dp = NULL;
+	char *first;
 	const sopno gf = g->firststate+1;	/* +1 for OEND */
 	const sopno gl = g->laststate;
 	char *start;
@@ -165,6 +172,15 @@ matcher(
 	if (stop < start)
 		return(REG_INVARG);
 
+	/* a match anchored at the start must begin right there */
+	if (g->iflags&ANCHORED) {
+		if ((eflags&REG_NOTBOL) ||
+		    (g->plen > 0 && (stop - start < g->plen ||
+				     memcmp(start, g->prefix, g->plen) != 0)) ||
+		    (g->nfirst > 0 && (start == stop || !ISFIRST(g, *start))))
+			return(REG_NOMATCH);
+	}
+
 	/* prescreening; this does wonders for this rather slow code */
 	if (g->must != NULL) {
 		if (g->charjump != NULL && g->matchjump != NULL) {
@@ -199,16 +215,20 @@ matcher(
 			if (pp != mustfirst)
 				return(REG_NOMATCH);
 		} else {
-			for (dp = start; dp < stop; dp++)
-				if (*dp == g->must[0] &&
-				    stop - dp >= g->mlen &&
-				    memcmp(dp, g->must, (size_t)g->mlen) == 0)
-					break;
-			if (dp == stop)		/* we didn't find g->must */
+			dp = memmem(start, stop - start, g->must, g->mlen);
+			if (dp == NULL)		/* we didn't find g->must */
 				return(REG_NOMATCH);
 		}
 	}
 
+	/* skip to the first byte which could start a match */
+	first = start;
+	if (g->nfirst > 0 && !(g->iflags&ANCHORED)) {
+		first = skipfirst(g, start, start, stop);
+		if (first == stop)
+			return(REG_NOMATCH);
+	}
+
 	/* match struct setup */
 	m->g = g;
 	m->eflags = eflags;
@@ -227,9 +247,15 @@ matcher(
 	/* Adjust start according to moffset, to speed things up */
 	if (g->moffset > -1)
 		start = ((dp - g->moffset) < start) ? start : dp - g->moffset;
+	if (start < first)
+		start = first;
 
 	/* this loop does only one repetition except for backrefs */
 	for (;;) {
+#ifdef __REGEX_DFA_STATES
+		if (g->dfa == NULL || (eflags&REG_LARGE) ||
+		    dfast(m, start, stop, gf, gl, &endp) != 0)
+#endif
 		endp = fast(m, start, stop, gf, gl);
 		if (endp == NULL) {		/* a miss */
 			STATETEARDOWN(m);
@@ -754,6 +780,8 @@ fast(
 	int flagch;
 	int i;
 	char *coldp;		/* last p after which no match was underway */
+	char *q;
+	int skip = (m->g->iflags&ANCHORED) || m->g->nfirst > 0;
 
 	CLEAR(st);
 	SET1(st, startst);
@@ -765,8 +793,18 @@ fast(
 		/* next character */
 		lastc = c;
 		c = (p == m->endp) ? OUT : *p;
-		if (EQ(st, fresh))
+		if (EQ(st, fresh)) {
+			/* nothing underway, skip what cannot start a match */
+			if (skip && p != stop) {
+				q = skipfirst(m->g, m->beginp, p, stop);
+				if (q != p) {
+					p = q;
+					lastc = *(p-1);
+					c = (p == m->endp) ? OUT : *p;
+				}
+			}
 			coldp = p;
+		}
 
 		/* is there an EOL and/or BOL between lastc and c? */
 		flagch = '\0';
@@ -911,6 +949,253 @@ slow(
 }
 
 
+#ifndef SKIPDONE
+#define	SKIPDONE	/* never again */
+/*
+ - skipfirst - find the next place a match could start
+ == static char *skipfirst(struct re_guts *g, char *beginp, char *p, \
+ ==	char *stop);
+ *
+ * Only for use when nothing is underway, so that a byte which cannot
+ * start a match leaves the state set as it was.
+ */
+static char *			/* where to resume, stop if nowhere */
+skipfirst(struct re_guts *g,
+	  char *beginp,
+	  char *p,
+	  char *stop)
+{
+	if (g->iflags&ANCHORED)
+		return((p == beginp) ? p : stop);
+	if (g->nfirst == 1) {
+		p = memchr(p, g->firstch, stop - p);
+		return((p == NULL) ? stop : p);
+	}
+	while (p < stop && !g->first[(uch)*p])
+		p++;
+	return(p);
+}
+#endif
+
+#ifdef __REGEX_DFA_STATES
+#ifndef DFADONE
+#define	DFADONE		/* never again */
+/*
+ - dfaintern - find or add the DFA state for a state set
+ == static int dfaintern(struct re_dfa *d, const char *key, int flags);
+ *
+ * Returns DFA_UNKNOWN when the cache is full.
+ */
+static int			/* DFA state number */
+dfaintern(struct re_dfa *d,
+	  const char *key,
+	  int flags)
+{
+	unsigned int h = flags;
+	size_t i;
+	int s;
+	char *k;
+
+	for (i = 0; i < d->keysize; i++)
+		h = h * 31 + (uch)key[i];
+	for (s = 0; s < d->nstates; s++)
+		if (d->hash[s] == h && d->flags[s] == flags &&
+		    memcmp(d->keys + s * d->keysize, key, d->keysize) == 0)
+			return(s);
+	if (s == DFA_STATES)
+		return(DFA_UNKNOWN);
+
+	k = d->keys + s * d->keysize;
+	memcpy(k, key, d->keysize);
+	d->hash[s] = h;
+	d->flags[s] = flags;
+	for (i = 0; i < (size_t)d->ntrans; i++)
+		d->next[s * d->ntrans + i] = DFA_UNKNOWN;
+	d->nstates++;
+	return(s);
+}
+
+/*
+ - dfaflush - empty a full DFA cache, unless it is thrashing
+ == static int dfaflush(struct re_dfa *d, size_t scanned);
+ */
+static int			/* 0 flushed, -1 gave up on the cache */
+dfaflush(struct re_dfa *d,
+	 size_t scanned)	/* bytes scanned since the last flush */
+{
+	if (scanned < (size_t)DFA_MINSCAN * DFA_STATES) {
+		d->disabled = 1;
+		return(-1);
+	}
+	d->nstates = 0;
+	d->start[0] = d->start[1] = DFA_UNKNOWN;
+	d->scanned = 0;
+	return(0);
+}
+#endif
+
+/*
+ - dfast - fast() driven by the lazy DFA cache
+ == static int dfast(struct match *m, char *start, char *stop, \
+ ==	sopno startst, sopno stopst, char **endp);
+ *
+ * Each input byte costs one table lookup once its transition has been
+ * seen; new transitions are worked out exactly as fast() would.  Sets
+ * *endp and m->coldp as fast() does and returns 0, or returns -1 when
+ * the cache is of no use and fast() has to do the work.
+ */
+static int			/* 0 done, -1 use fast() */
+dfast(
+	struct match *m,
+	char *start,
+	char *stop,
+	sopno startst,
+	sopno stopst,
+	char **endp
+)
+{
+	struct re_dfa *d = m->g->dfa;
+	states st = m->st;
+	states fresh = m->fresh;
+	states tmp = m->tmp;
+	int havefresh = 0;
+	char *p = start;
+	char *mark = start;	/* where scanning since the last flush began */
+	char *coldp = NULL;	/* last p after which no match was underway */
+	int lastc = (start == m->beginp) ? OUT : *(start-1);
+	int bol;
+	int s;			/* current DFA state */
+	int ns;			/* next DFA state */
+	int cl;			/* class of the current byte */
+	int c;
+	int flagch;
+	int flags;
+	int i;
+	short *t;
+	char *q;
+	int skip = (m->g->iflags&ANCHORED) || m->g->nfirst > 0;
+
+	__lock_acquire(d->lock);
+	if (d->disabled) {
+		__lock_release(d->lock);
+		return(-1);
+	}
+
+	if (lastc == OUT)
+		bol = !(m->eflags&REG_NOTBOL);
+	else
+		bol = (lastc == '\n' && (m->g->cflags&REG_NEWLINE));
+	s = d->start[bol];
+	for (;;) {
+		if (s == DFA_UNKNOWN) {
+			/* (re)enter the start state */
+			if (!havefresh) {
+				CLEAR(fresh);
+				SET1(fresh, startst);
+				fresh = step(m->g, startst, stopst, fresh, NOTHING, fresh);
+				havefresh = 1;
+			}
+			flags = DFA_FRESH | (bol ? DFA_BOL : 0);
+			s = dfaintern(d, STATEKEY(fresh), flags);
+			if (s == DFA_UNKNOWN) {
+				if (dfaflush(d, d->scanned + (p - mark)) < 0)
+					break;
+				mark = p;
+				s = dfaintern(d, STATEKEY(fresh), flags);
+			}
+			d->start[bol] = s;
+		}
+
+		if (d->flags[s]&DFA_FRESH) {
+			/* nothing underway, skip what cannot start a match */
+			if (skip && p != stop) {
+				q = skipfirst(m->g, m->beginp, p, stop);
+				if (q != p) {
+					p = q;
+					bol = (p[-1] == '\n' &&
+					       (m->g->cflags&REG_NEWLINE));
+					s = d->start[bol];
+					if (s == DFA_UNKNOWN)
+						continue;
+				}
+			}
+			coldp = p;
+		}
+		if (p == stop)
+			cl = d->nclasses + ((m->eflags&REG_NOTEOL) != 0);
+		else
+			cl = d->classmap[(uch)*p];
+		t = &d->next[s * d->ntrans + cl];
+		ns = *t;
+
+		if (ns == DFA_UNKNOWN) {
+			/* new transition, do what fast() does */
+			if (!havefresh) {
+				CLEAR(fresh);
+				SET1(fresh, startst);
+				fresh = step(m->g, startst, stopst, fresh, NOTHING, fresh);
+				havefresh = 1;
+			}
+			memcpy(STATEKEY(st), d->keys + s * d->keysize, d->keysize);
+			c = (cl < d->nclasses) ? d->rep[cl] : OUT;
+
+			flagch = '\0';
+			i = 0;
+			if (d->flags[s]&DFA_BOL) {
+				flagch = BOL;
+				i = m->g->nbol;
+			}
+			if ( (c == '\n' && m->g->cflags&REG_NEWLINE) ||
+					cl == d->nclasses ) {
+				flagch = (flagch == BOL) ? BOLEOL : EOL;
+				i += m->g->neol;
+			}
+			for (; i > 0; i--)
+				st = step(m->g, startst, stopst, st, flagch, st);
+
+			if (ISSET(st, stopst))
+				ns = DFA_MATCH;
+			else if (c == OUT)
+				ns = DFA_NOMATCH;
+			else {
+				ASSIGN(tmp, st);
+				ASSIGN(st, fresh);
+				st = step(m->g, startst, stopst, tmp, c, st);
+				flags = (c == '\n' && m->g->cflags&REG_NEWLINE) ?
+					DFA_BOL : 0;
+				if (EQ(st, fresh))
+					flags |= DFA_FRESH;
+				ns = dfaintern(d, STATEKEY(st), flags);
+				if (ns == DFA_UNKNOWN) {
+					if (dfaflush(d, d->scanned + (p - mark)) < 0)
+						break;
+					mark = p;
+					ns = dfaintern(d, STATEKEY(st), flags);
+					t = NULL;	/* s went with the flush */
+				}
+			}
+			if (t != NULL)
+				*t = ns;
+		}
+
+		if (ns == DFA_MATCH || ns == DFA_NOMATCH) {
+			d->scanned += p - mark;
+			__lock_release(d->lock);
+			assert(coldp != NULL);
+			m->coldp = coldp;
+			*endp = (ns == DFA_MATCH) ? p+1 : NULL;
+			return(0);
+		}
+		s = ns;
+		p++;
+	}
+
+	/* the cache is thrashing */
+	__lock_release(d->lock);
+	return(-1);
+}
+#endif
+
 /*
  - step - map set of states reachable before char to set reachable after
  == static states step(struct re_guts *g, sopno start, sopno stop, \
@@ -1132,3 +1417,4 @@ pchar(int ch)
 #undef	print
 #undef	at
 #undef	match
+#undef	dfast
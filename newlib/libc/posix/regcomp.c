@@ -119,9 +119,14 @@ static void enlarge(struct parse *p, sopno size);
 static void stripsnug(struct parse *p, struct re_guts *g);
 static void findmust(struct parse *p, struct re_guts *g);
 static int altoffset(sop *scan, int offset, int mccs);
+static void findprefix(struct parse *p, struct re_guts *g);
+static int firstbytes(struct re_guts *g, sopno pc, char *first, char *seen);
 static void computejumps(struct parse *p, struct re_guts *g);
 static void computematchjumps(struct parse *p, struct re_guts *g);
 static sopno pluscount(struct parse *p, struct re_guts *g);
+#ifdef __REGEX_DFA_STATES
+static void dfainit(struct parse *p, struct re_guts *g);
+#endif
 
 /* ========= end header generated by ./mkh ========= */
 
@@ -238,11 +243,18 @@ regcomp(regex_t *__restrict preg, const char *__restrict pattern, int cflags)
 	g->charjump = NULL;
 	g->matchjump = NULL;
 	g->mlen = 0;
+	g->prefix = NULL;
+	g->plen = 0;
+	g->nfirst = 0;
+	g->first = NULL;
 	g->nsub = 0;
 	g->ncategories = 1;	/* category 0 is "everything else" */
 	g->categories = &g->catspace[-(CHAR_MIN)];
 	(void) memset((char *)g->catspace, 0, NC*sizeof(cat_t));
 	g->backrefs = 0;
+#ifdef __REGEX_DFA_STATES
+	g->dfa = NULL;
+#endif
 
 	/* do it */
 	EMIT(OEND, 0);
@@ -260,6 +272,7 @@ regcomp(regex_t *__restrict preg, const char *__restrict pattern, int cflags)
 	categorize(p, g);
 	stripsnug(p, g);
 	findmust(p, g);
+	findprefix(p, g);
 	/* only use Boyer-Moore algorithm if the pattern is bigger
 	 * than three characters
 	 */
@@ -272,6 +285,9 @@ regcomp(regex_t *__restrict preg, const char *__restrict pattern, int cflags)
 		}
 	}
 	g->nplus = pluscount(p, g);
+#ifdef __REGEX_DFA_STATES
+	dfainit(p, g);
+#endif
 	g->magic = MAGIC2;
 	preg->re_nsub = g->nsub;
 	preg->re_g = g;
@@ -1853,6 +1869,163 @@ findmust(
 	*cp++ = '\0';		/* just on general principles */
 }
 
+/*
+ - findprefix - fill in what matches must start with
+ == static void findprefix(struct parse *p, struct re_guts *g);
+ *
+ * Finds whether matches can only start at the start of the string,
+ * and if so the literal string they start with, and the set of bytes
+ * a match can start with.  regexec uses these to reject strings and
+ * to skip ahead with memchr instead of running the state machine.
+ */
+static void
+findprefix(
+	struct parse *p,
+	struct re_guts *g
+)
+{
+	sop *scan;
+	sop s;
+	char *cp;
+	char *first;
+	char *seen;
+	int cs;
+	int c;
+	int n;
+
+	/* avoid making error situations worse */
+	if (p->error != 0)
+		return;
+
+	/* a leading ^ and then ordinary characters, parentheses aside */
+	n = 0;
+	scan = g->strip + 1;
+	for (;;) {
+		s = *scan++;
+		if (OP(s) == OBOL && n == 0) {
+			if (!(g->cflags&REG_NEWLINE))
+				g->iflags |= ANCHORED;
+		} else if (OP(s) == OCHAR)
+			n++;
+		else if (OP(s) != OLPAREN && OP(s) != ORPAREN)
+			break;
+	}
+	/* elsewhere, must and the first bytes do better than a prefix */
+	if (n > 0 && (g->iflags&ANCHORED)) {
+		g->prefix = malloc((size_t)n + 1);
+		if (g->prefix != NULL) {
+			cp = g->prefix;
+			scan = g->strip + 1;
+			while (cp < g->prefix + n) {
+				s = *scan++;
+				if (OP(s) == OCHAR)
+					*cp++ = (char)OPND(s);
+			}
+			*cp = '\0';
+			g->plen = n;
+		}
+	}
+
+	/* the possible first bytes, unless multi-character elements or
+	 * empty matches get in the way */
+	for (cs = 0; cs < g->ncsets; cs++)
+		if (g->sets[cs].multis != NULL)
+			return;
+	first = calloc(NC, 1);
+	seen = calloc(g->nstates, 1);
+	if (first != NULL && seen != NULL &&
+	    firstbytes(g, g->firststate + 1, first, seen) == 0) {
+		n = 0;
+		for (c = 0; c < NC; c++)
+			if (first[c]) {
+				g->firstch = c;
+				n++;
+			}
+		if (n == 1 || (n > 1 && n <= NC/4)) {
+			g->nfirst = n;
+			if (n > 1) {
+				g->first = first;
+				first = NULL;
+			}
+		}
+	}
+	free(first);
+	free(seen);
+}
+
+/*
+ - firstbytes - mark the bytes a match starting at pc can start with
+ == static int firstbytes(struct re_guts *g, sopno pc, char *first, \
+ ==	char *seen);
+ */
+static int			/* 0 ok, -1 if the match can be empty */
+firstbytes(
+	struct re_guts *g,
+	sopno pc,
+	char *first,
+	char *seen			/* strip entries already handled */
+)
+{
+	sop s;
+	sopno look;
+	cset *cs;
+	int c;
+
+	for (;;) {
+		if (seen[pc])
+			return(0);
+		seen[pc] = 1;
+		s = g->strip[pc];
+		switch (OP(s)) {
+		case OCHAR:
+			first[(uch)OPND(s)] = 1;
+			return(0);
+		case OANY:
+			memset(first, 1, NC);
+			return(0);
+		case OANYOF:
+			cs = &g->sets[OPND(s)];
+			for (c = 0; c < NC; c++)
+				if (CHIN(cs, c))
+					first[c] = 1;
+			return(0);
+		case OBOL:		/* empty, go on */
+		case OEOL:
+		case OBOW:
+		case OEOW:
+		case OLPAREN:
+		case ORPAREN:
+		case OPLUS_:
+		case O_PLUS:
+		case O_QUEST:
+		case O_CH:
+			pc++;
+			break;
+		case OQUEST_:		/* the body, or skip it */
+			if (firstbytes(g, pc + 1, first, seen) < 0)
+				return(-1);
+			pc += OPND(s);
+			break;
+		case OCH_:		/* each branch */
+			if (firstbytes(g, pc + 1, first, seen) < 0)
+				return(-1);
+			for (look = pc + OPND(s); OP(g->strip[look]) == OOR2;
+			     look += OPND(g->strip[look]))
+				if (firstbytes(g, look + 1, first, seen) < 0)
+					return(-1);
+			return(0);
+		case OOR1:		/* end of a branch, on to the O_CH */
+			for (look = 1; OP(g->strip[pc+look]) != O_CH;
+			     look += OPND(g->strip[pc+look]))
+				continue;
+			pc += look;
+			break;
+		default:		/* OEND, back references */
+			return(-1);
+		}
+	}
+}
+
 /*
  - altoffset - choose biggest offset among multiple choices
  == static int altoffset(sop *scan, int offset, int mccs);
@@ -2098,3 +2271,82 @@ pluscount(
 		g->iflags |= BAD;
 	return(maxnest);
 }
+
+#ifdef __REGEX_DFA_STATES
+/*
+ - dfainit - set up the lazy DFA cache used by regexec
+ == static void dfainit(struct parse *p, struct re_guts *g);
+ *
+ * The byte classes come from the character categories, except that
+ * newline needs its own class under REG_NEWLINE as it starts and ends
+ * lines.  Failing to allocate the cache is not an error, regexec just
+ * uses the NFA.
+ */
+static void
+dfainit(
+	struct parse *p,
+	struct re_guts *g
+)
+{
+	struct re_dfa *d;
+	short catclass[NC];
+	int c;
+	int n;
+	sopno i;
+
+	if (p->error != 0 || g->backrefs || g->ncategories > NC)
+		return;
+	for (i = 0; i < g->nstates; i++)
+		if (OP(g->strip[i]) == OBOW || OP(g->strip[i]) == OEOW)
+			return;
+
+	d = (struct re_dfa *)malloc(sizeof(struct re_dfa));
+	if (d == NULL)
+		return;
+
+	for (c = 0; c < NC; c++)
+		catclass[c] = -1;
+	n = 0;
+	for (c = CHAR_MIN; c <= CHAR_MAX; c++) {
+		if (c == '\n' && (g->cflags&REG_NEWLINE)) {
+			if (n == NC)
+				break;
+			d->classmap[(uch)c] = n;
+			d->rep[n++] = c;
+			continue;
+		}
+		if (catclass[g->categories[c]] < 0) {
+			if (n == NC)
+				break;
+			catclass[g->categories[c]] = n;
+			d->rep[n++] = c;
+		}
+		d->classmap[(uch)c] = catclass[g->categories[c]];
+	}
+	if (c <= CHAR_MAX) {		/* too many classes */
+		free((char *)d);
+		return;
+	}
+
+	d->disabled = 0;
+	d->nclasses = n;
+	d->ntrans = n + 2;
+	if (g->nstates <= (sopno)(CHAR_BIT*sizeof(long)))
+		d->keysize = sizeof(long);
+	else
+		d->keysize = g->nstates;
+	d->nstates = 0;
+	d->start[0] = d->start[1] = DFA_UNKNOWN;
+	d->scanned = 0;
+	d->next = (short *)malloc(DFA_STATES * d->ntrans * sizeof(short));
+	d->keys = (char *)malloc(DFA_STATES * d->keysize);
+	if (d->next == NULL || d->keys == NULL) {
+		free((char *)d->next);
+		free(d->keys);
+		free((char *)d);
+		return;
+	}
+	__lock_init(d->lock);
+	g->dfa = d;
+}
+#endif
@@ -133,6 +133,47 @@ typedef struct {
 /* stuff for character categories */
 typedef unsigned char cat_t;
 
+#ifdef __REGEX_DFA_STATES
+/*
+ * Lazily built DFA for fast(), used when there are no back references
+ * or word boundaries.  A DFA state is a set of strip states plus
+ * whether the previous character started a line.  Input bytes are
+ * mapped to classes which step() cannot tell apart; two more classes
+ * stand for the end of the string with and without REG_NOTEOL.
+ * Transitions are computed with step() the first time they are taken.
+ * When all DFA_STATES slots are used the cache is flushed, unless
+ * fewer than DFA_MINSCAN bytes per slot were scanned since the last
+ * flush, in which case the cache is thrashing and the NFA takes over.
+ */
+#include <sys/lock.h>
+
+#define	DFA_STATES	__REGEX_DFA_STATES
+#define	DFA_MINSCAN	16
+#define	DFA_UNKNOWN	(-1)	/* transition not computed yet */
+#define	DFA_MATCH	(-2)	/* stopst reached */
+#define	DFA_NOMATCH	(-3)	/* end of string without a match */
+#define	DFA_BOL		01	/* state flags: previous char started a line */
+#define	DFA_FRESH	02	/* state is the fresh start state */
+struct re_dfa {
+#ifndef __SINGLE_THREAD
+	_LOCK_T lock;		/* regexec may be called from several threads */
+#endif
+	int disabled;		/* cache thrashed, use the NFA */
+	int nclasses;		/* byte classes, not counting end classes */
+	int ntrans;		/* transitions per state, nclasses+2 */
+	size_t keysize;		/* bytes per stored state set */
+	int nstates;		/* DFA states in use */
+	int start[2];		/* start state, by DFA_BOL, or DFA_UNKNOWN */
+	size_t scanned;		/* bytes scanned since the last flush */
+	uch classmap[NC];	/* byte -> class */
+	char rep[NC];		/* class -> a byte in it */
+	unsigned char flags[DFA_STATES];
+	unsigned int hash[DFA_STATES];
+	short *next;		/* -> short[DFA_STATES][ntrans] */
+	char *keys;		/* -> char[DFA_STATES][keysize] */
+};
+#endif
+
 /*
  * main compiled-expression structure
  */
@@ -152,6 +193,7 @@ struct re_guts {
 #		define	USEBOL	01	/* used ^ */
 #		define	USEEOL	02	/* used $ */
 #		define	BAD	04	/* something wrong */
+#		define	ANCHORED 010	/* matches only at start of string */
 	int nbol;		/* number of ^ used */
 	int neol;		/* number of $ used */
 	int ncategories;	/* how many character categories */
@@ -161,9 +203,17 @@ struct re_guts {
 	int *charjump;		/* Boyer-Moore char jump table */
 	int *matchjump;		/* Boyer-Moore match jump table */
 	int mlen;		/* length of must */
+	char *prefix;		/* ANCHORED matches start with this string */
+	int plen;		/* length of prefix */
+	int nfirst;		/* number of bytes a match can start with */
+	int firstch;		/* the only one, when nfirst == 1 */
+	char *first;		/* -> char[NC] of them, when nfirst > 1 */
 	size_t nsub;		/* copy of re_nsub */
 	int backrefs;		/* does it use back references? */
 	sopno nplus;		/* how deep does it nest +s? */
+#ifdef __REGEX_DFA_STATES
+	struct re_dfa *dfa;	/* lazy DFA cache, or NULL */
+#endif
 	/* catspace must be last */
 	cat_t catspace[NC];	/* categories */
 };
@@ -171,3 +221,5 @@ struct re_guts {
 /* misc utilities */
 #define	OUT	(CHAR_MAX+1)	/* a non-character value */
 #define ISWORD(c)       (isalnum((uch)(c)) || (c) == '_')
+#define	ISFIRST(g, c)	((g)->nfirst == 1 ? (uch)(c) == (g)->firstch : \
+			 (g)->first[(uch)(c)])
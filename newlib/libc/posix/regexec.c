@@ -46,6 +46,7 @@ static char sccsid[] = "@(#)regexec.c	8.3 (Berkeley) 3/20/94";
  * macros that code uses.  This lets the same code operate on two different
  * representations for state sets.
  */
+#define _GNU_SOURCE
 #include <sys/types.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -83,6 +84,8 @@ static int nope = 0;		/* for use in asserts; shuts lint up */
 #define	FWD(dst, src, n)	((dst) |= ((unsigned long)(src)&(here)) << (n))
 #define	BACK(dst, src, n)	((dst) |= ((unsigned long)(src)&(here)) >> (n))
 #define	ISSETBACK(v, n)	(((v) & ((unsigned long)here >> (n))) != 0)
+/* bytes of a state set for the DFA cache */
+#define	STATEKEY(v)	((char *)&(v))
 /* function names */
 #define SNAMES			/* engine.c looks after details */
 
@@ -107,6 +110,7 @@ static int nope = 0;		/* for use in asserts; shuts lint up */
 #undef	FWD
 #undef	BACK
 #undef	ISSETBACK
+#undef	STATEKEY
 #undef	SNAMES
 
 /* macros for manipulating states, large version */
@@ -132,6 +136,8 @@ static int nope = 0;		/* for use in asserts; shuts lint up */
 #define	FWD(dst, src, n)	((dst)[here+(n)] |= (src)[here])
 #define	BACK(dst, src, n)	((dst)[here-(n)] |= (src)[here])
 #define	ISSETBACK(v, n)	((v)[here - (n)])
+/* bytes of a state set for the DFA cache */
+#define	STATEKEY(v)	(v)
 /* function names */
 #define	LNAMES			/* flag */
 
@@ -78,6 +78,18 @@ regfree(regex_t *preg)
                 free(g->charjump);
 	if (g->matchjump != NULL)
 		free(g->matchjump);
+	if (g->prefix != NULL)
+		free(g->prefix);
+	if (g->first != NULL)
+		free(g->first);
+#ifdef __REGEX_DFA_STATES
+	if (g->dfa != NULL) {
+		__lock_close(g->dfa->lock);
+		free((char *)g->dfa->next);
+		free(g->dfa->keys);
+		free((char *)g->dfa);
+	}
+#endif
 	free((char *)g);
 }
 
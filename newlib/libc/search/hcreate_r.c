@@ -58,6 +58,203 @@
 #include "page.h"
 #include "extern.h"
 
+#ifdef __HSEARCH_OPEN_ADDRESSING
+
+/*
+ * Open addressing with linear probing. Each slot caches the key hash
+ * so that probing only touches keys whose hash matches, and the slot
+ * array doubles whenever it gets three quarters full, re-using the
+ * cached hashes instead of hashing the keys again.
+ *
+ * Entries are allocated in blocks, each as large as all of the
+ * previous ones together, so that ENTRY pointers handed back by
+ * hsearch_r never move when the slot array is resized.
+ */
+struct internal_slot {
+	ENTRY *ent;			/* NULL for an empty slot */
+	__uint32_t hash;
+};
+
+#define	MIN_SLOTS	16
+#define	MAX_BLOCKS	(sizeof (size_t) * 8)
+#define	MAX_SLOTS	((~(size_t) 0 >> 1) / sizeof (struct internal_slot) + 1)
+
+struct internal_head {
+	struct internal_slot *slots;
+	size_t nslots;			/* power of two */
+	size_t count;			/* entries in use */
+	ENTRY *next;			/* next free entry in the last block */
+	size_t avail;			/* free entries left in the last block */
+	size_t nblocks;
+	ENTRY *blocks[MAX_BLOCKS];
+};
+
+/* Keep the load factor at or below 3/4 */
+static size_t
+max_count(size_t nslots)
+{
+	return nslots - (nslots >> 2);
+}
+
+int
+hcreate_r(size_t nel, struct hsearch_data *htab)
+{
+	struct internal_head *head;
+	size_t nslots;
+
+	/* Make sure this this isn't called when a table already exists. */
+	if (htab->htable != NULL) {
+		errno = EINVAL;
+		return 0;
+	}
+
+	/* Size the table so nel entries fit without growing */
+	for (nslots = MIN_SLOTS; max_count(nslots) < nel && nslots < MAX_SLOTS; )
+		nslots <<= 1;
+
+	head = calloc(1, sizeof *head);
+	if (head == NULL) {
+		errno = ENOMEM;
+		return 0;
+	}
+	head->slots = calloc(nslots, sizeof head->slots[0]);
+	if (head->slots == NULL) {
+		free(head);
+		errno = ENOMEM;
+		return 0;
+	}
+	head->nslots = nslots;
+	htab->htable = head;
+	htab->htablesize = nslots;
+	return 1;
+}
+
+void
+hdestroy_r(struct hsearch_data *htab)
+{
+	struct internal_head *head = htab->htable;
+	size_t b;
+
+	if (head == NULL)
+		return;
+
+	for (b = 0; b < head->nblocks; b++)
+		free(head->blocks[b]);
+	free(head->slots);
+	free(head);
+	htab->htable = NULL;
+}
+
+/* Double the slot array, placing entries by their cached hashes */
+static int
+grow(struct internal_head *head)
+{
+	struct internal_slot *slots, *old = head->slots;
+	size_t nslots = head->nslots << 1;
+	size_t mask = nslots - 1;
+	size_t i, j;
+
+	if (head->nslots >= MAX_SLOTS)
+		return 0;
+	slots = calloc(nslots, sizeof slots[0]);
+	if (slots == NULL)
+		return 0;
+	for (i = 0; i < head->nslots; i++) {
+		if (old[i].ent == NULL)
+			continue;
+		for (j = old[i].hash & mask; slots[j].ent != NULL; j = (j + 1) & mask)
+			;
+		slots[j] = old[i];
+	}
+	free(old);
+	head->slots = slots;
+	head->nslots = nslots;
+	return 1;
+}
+
+static ENTRY *
+new_entry(struct internal_head *head)
+{
+	if (head->avail == 0) {
+		size_t n = head->count < MIN_SLOTS ? MIN_SLOTS : head->count;
+		ENTRY *block;
+
+		if (head->nblocks == MAX_BLOCKS)
+			return NULL;
+		block = malloc(n * sizeof *block);
+		if (block == NULL)
+			return NULL;
+		head->blocks[head->nblocks++] = block;
+		head->next = block;
+		head->avail = n;
+	}
+	head->avail--;
+	return head->next++;
+}
+
+int
+hsearch_r(ENTRY item, ACTION action, ENTRY **retval, struct hsearch_data *htab)
+{
+	struct internal_head *head = htab->htable;
+	struct internal_slot *slot;
+	__uint32_t hashval;
+	size_t mask, i;
+	ENTRY *ent;
+
+	hashval = __default_hash(item.key, strlen(item.key));
+
+	mask = head->nslots - 1;
+	for (i = hashval & mask; (slot = &head->slots[i])->ent != NULL; i = (i + 1) & mask) {
+		if (slot->hash == hashval && strcmp(slot->ent->key, item.key) == 0)
+		  {
+		    *retval = slot->ent;
+		    return 1;
+		  }
+	}
+
+	if (action == FIND)
+	  {
+	    *retval = NULL;
+	    return 0;
+	  }
+
+	/*
+	 * Grow before inserting when the table is getting full. If
+	 * that fails, keep going as long as one empty slot remains to
+	 * terminate searches.
+	 */
+	if (head->count >= max_count(head->nslots)) {
+		if (grow(head)) {
+			htab->htablesize = head->nslots;
+			mask = head->nslots - 1;
+			for (i = hashval & mask; head->slots[i].ent != NULL; i = (i + 1) & mask)
+				;
+			slot = &head->slots[i];
+		} else if (head->count + 1 >= head->nslots) {
+			*retval = NULL;
+			errno = ENOMEM;
+			return 0;
+		}
+	}
+
+	ent = new_entry(head);
+	if (ent == NULL)
+	  {
+	    *retval = NULL;
+	    errno = ENOMEM;
+	    return 0;
+	  }
+	ent->key = item.key;
+	ent->data = item.data;
+	slot->ent = ent;
+	slot->hash = hashval;
+	head->count++;
+	*retval = ent;
+	return 1;
+}
+
+#else /* __HSEARCH_OPEN_ADDRESSING */
+
 /*
  * DO NOT MAKE THIS STRUCTURE LARGER THAN 32 BYTES (4 ptrs on 64-bit
  * ptr machine) without adjusting MAX_BUCKETS_LG2 below.
@@ -192,3 +389,5 @@ hsearch_r(ENTRY item, ACTION action, ENTRY **retval, struct hsearch_data *htab)
         *retval = &ie->ent;
 	return 1;
 }
+
+#endif /* __HSEARCH_OPEN_ADDRESSING */
@@ -101,16 +101,21 @@ typedef unsigned long swap_ulong_t;
                 } while (--i > 0);              \
         } while(0)
 
+/*
+ * swaptype is 0 when elements are a single TYPE, 1 when they are two
+ * of them, 2 for other multiples and 3 when TYPE can't be used at all.
+ */
 #define	SWAPINIT(TYPE, a, es) swaptype_ ## TYPE =	\
 	((uintptr_t)(a) % sizeof(TYPE)) ||	\
-	((es) % sizeof(TYPE)) ? 2 : ((es) == sizeof(TYPE)) ? 0 : 1;
+	((es) % sizeof(TYPE)) ? 3 : ((es) == sizeof(TYPE)) ? 0 : \
+	((es) == 2 * sizeof(TYPE)) ? 1 : 2;
 
 static inline void
 swapfunc(char *a, char *b, size_t n, int swaptype_swap_ulong_t, int swaptype_swap_uint_t)
 {
-	if (swaptype_swap_ulong_t <= 1)
+	if (swaptype_swap_ulong_t <= 2)
 		swapcode(swap_ulong_t, a, b, n);
-        else if (need_both_sizes() && swaptype_swap_uint_t <= 1)
+        else if (need_both_sizes() && swaptype_swap_uint_t <= 2)
                 swapcode(swap_uint_t, a, b, n);
 	else
 		swapcode(unsigned char, a, b, n);
@@ -121,6 +126,14 @@ swapfunc(char *a, char *b, size_t n, int swaptype_swap_ulong_t, int swaptype_swa
                 swap_ulong_t t = *(swap_ulong_t *)(a);                  \
                 *(swap_ulong_t *)(a) = *(swap_ulong_t *)(b);            \
                 *(swap_ulong_t *)(b) = t;                               \
+        } else if (swaptype_swap_ulong_t == 1) {                        \
+                swap_ulong_t *sa = (swap_ulong_t *)(a);                 \
+                swap_ulong_t *sb = (swap_ulong_t *)(b);                 \
+                swap_ulong_t t0 = sa[0], t1 = sa[1];                    \
+                sa[0] = sb[0];                                          \
+                sa[1] = sb[1];                                          \
+                sb[0] = t0;                                             \
+                sb[1] = t1;                                             \
         } else if (need_both_sizes() && swaptype_swap_uint_t == 0) {    \
                 swap_uint_t t = *(swap_uint_t *)(a);                    \
                 *(swap_uint_t *)(a) = *(swap_uint_t *)(b);              \
@@ -139,22 +152,89 @@ swapfunc(char *a, char *b, size_t n, int swaptype_swap_ulong_t, int swaptype_swa
 #define	CMP(t, x, y) (cmp((x), (y)))
 #endif
 
+#if defined(I_AM_QSORT_R) || defined(I_AM_GNU_QSORT_R)
+#define __thunk_unused
+#else
+#define __thunk_unused __unused
+#endif
+
 static __inline char *
 med3 (char *a,
 	char *b,
 	char *c,
 	cmp_t *cmp,
-	void *thunk
-#if !defined(I_AM_QSORT_R) && !defined(I_AM_GNU_QSORT_R)
-__unused
-#endif
-)
+	void *thunk __thunk_unused)
 {
 	return CMP(thunk, a, b) < 0 ?
 	       (CMP(thunk, b, c) < 0 ? b : (CMP(thunk, a, c) < 0 ? c : a ))
               :(CMP(thunk, b, c) > 0 ? b : (CMP(thunk, a, c) < 0 ? a : c ));
 }
 
+/*
+ * Heapsort, used when quicksort partitioning keeps going badly so
+ * that the total stays O(n log n) whatever the input.
+ */
+static void
+siftdown(char *a, size_t root, size_t n, size_t es, cmp_t *cmp,
+	 void *thunk __thunk_unused, int swaptype_swap_ulong_t,
+	 int swaptype_swap_uint_t)
+{
+	size_t child;
+
+	while ((child = 2 * root + 1) < n) {
+		if (child + 1 < n &&
+		    CMP(thunk, a + child * es, a + (child + 1) * es) < 0)
+			child++;
+		if (CMP(thunk, a + root * es, a + child * es) >= 0)
+			break;
+		swap(a + root * es, a + child * es);
+		root = child;
+	}
+}
+
+static void
+heapsort_fallback(char *a, size_t n, size_t es, cmp_t *cmp, void *thunk)
+{
+	int swaptype_swap_ulong_t, swaptype_swap_uint_t;
+	size_t i;
+
+	SWAPINIT(swap_ulong_t, a, es);
+	SWAPINIT(swap_uint_t, a, es);
+	for (i = n / 2; i-- > 0; )
+		siftdown(a, i, n, es, cmp, thunk,
+			 swaptype_swap_ulong_t, swaptype_swap_uint_t);
+	for (i = n; --i > 0; ) {
+		swap(a, a + i * es);
+		siftdown(a, 0, i, es, cmp, thunk,
+			 swaptype_swap_ulong_t, swaptype_swap_uint_t);
+	}
+}
+
+/*
+ * Insertion sort which gives up, returning 0, once it has moved more
+ * than 'limit' elements. Used when partitioning found nothing to
+ * swap, which usually means the range is already nearly sorted.
+ */
+static int
+insertion_sort(char *a, size_t n, size_t es, cmp_t *cmp,
+	       void *thunk __thunk_unused, size_t limit)
+{
+	int swaptype_swap_ulong_t, swaptype_swap_uint_t;
+	char *pl, *pm;
+	size_t moves = 0;
+
+	SWAPINIT(swap_ulong_t, a, es);
+	SWAPINIT(swap_uint_t, a, es);
+	for (pm = a + es; pm < a + n * es; pm += es) {
+		for (pl = pm; pl > a && CMP(thunk, pl - es, pl) > 0; pl -= es) {
+			swap(pl, pl - es);
+			if (++moves > limit)
+				return 0;
+		}
+	}
+	return 1;
+}
+
 /*
  * Classical function call recursion wastes a lot of stack space. Each
  * recursion level requires a full stack frame comprising all local variables
@@ -168,63 +248,44 @@ __unused
  * the parameter stack array is chosen to be similar to the stack frame
  * excluding the array. Each function call recursion level can handle this
  * number of iterative recursion levels.
+ *
+ * Each level also carries a depth budget, starting at log2(n). Splits
+ * leaving less than an eighth of the range on one side spend it, as do
+ * failed insertion sorts; when it runs out the range is heapsorted, as
+ * in Musser's introsort. Each budget unit costs O(n) so the total
+ * stays O(n log n).
  */
 #define PARAMETER_STACK_LEVELS 8u
 
-#if defined(I_AM_QSORT_R)
-void
-__bsd_qsort_r (void *a,
-	size_t n,
-	size_t es,
-	void *thunk,
-        cmp_t *cmp);
-
-void
-__bsd_qsort_r (void *a,
-	size_t n,
-	size_t es,
-	void *thunk,
-	cmp_t *cmp)
-#elif defined(I_AM_GNU_QSORT_R)
-void
-qsort_r (void *a,
-	size_t n,
-	size_t es,
-	cmp_t *cmp,
-	void *thunk)
-#else
-#define thunk NULL
-void
-qsort (void *a,
-	size_t n,
-	size_t es,
-	cmp_t *cmp)
-#endif
+static void
+introsort(char *a, size_t n, size_t es, cmp_t *cmp, void *thunk, size_t depth)
 {
 	char *pa, *pb, *pc, *pd, *pl, *pm, *pn;
 	size_t d, r;
 	int cmp_result;
 	int swaptype_swap_ulong_t, swaptype_swap_uint_t, swap_cnt;
 	size_t recursion_level = 0;
-	struct { void *a; size_t n; } parameter_stack[PARAMETER_STACK_LEVELS];
+	struct { char *a; size_t n; size_t depth; } parameter_stack[PARAMETER_STACK_LEVELS];
 
 	SWAPINIT(swap_ulong_t, a, es);
 	SWAPINIT(swap_uint_t, a, es);
 loop:	swap_cnt = 0;
 	if (n < 7) {
 		/* Short arrays are insertion sorted. */
-		for (pm = (char *) a + es; pm < (char *) a + n * es; pm += es)
-			for (pl = pm; pl > (char *) a && CMP(thunk, pl - es, pl) > 0;
-			     pl -= es)
-				swap(pl, pl - es);
+		insertion_sort(a, n, es, cmp, thunk, SIZE_MAX);
+		goto pop;
+	}
+
+	if (depth == 0) {
+		heapsort_fallback(a, n, es, cmp, thunk);
 		goto pop;
 	}
 
 	/* Select a pivot element, move it to the left. */
-	pm = (char *) a + (n / 2) * es;
+	pm = a + (n / 2) * es;
 	if (n > 7) {
 		pl = a;
-		pn = (char *) a + (n - 1) * es;
+		pn = a + (n - 1) * es;
 		if (n > 40) {
 			d = (n / 8) * es;
 			pl = med3(pl, pl + d, pl + 2 * d, cmp, thunk);
@@ -239,8 +300,8 @@ loop:	swap_cnt = 0;
 	 * Sort the array relative the pivot in four ranges as follows:
 	 * { elems == pivot, elems < pivot, elems > pivot, elems == pivot }
 	 */
-	pa = pb = (char *) a + es;
-	pc = pd = (char *) a + (n - 1) * es;
+	pa = pb = a + es;
+	pc = pd = a + (n - 1) * es;
 	for (;;) {
 		/* Scan left to right stopping at first element > pivot. */
 		while (pb <= pc && (cmp_result = CMP(thunk, pb, a)) <= 0) {
@@ -270,20 +331,25 @@ loop:	swap_cnt = 0;
 		pb += es;
 		pc -= es;
 	}
-	if (swap_cnt == 0) {  /* Switch to insertion sort */
-		for (pm = (char *) a + es; pm < (char *) a + n * es; pm += es)
-			for (pl = pm; pl > (char *) a && CMP(thunk, pl - es, pl) > 0;
-			     pl -= es)
-				swap(pl, pl - es);
-		goto pop;
+	if (swap_cnt == 0) {
+		/*
+		 * Nothing moved, so try insertion sort. Limit it to n
+		 * moves so that inputs built to defeat this check cost
+		 * O(n) per level instead of going quadratic; if it gives
+		 * up, partition the (now partly sorted) range again.
+		 */
+		if (insertion_sort(a, n, es, cmp, thunk, n))
+			goto pop;
+		depth--;
+		goto loop;
 	}
 
 	/*
 	 * Rearrange the array in three parts sorted like this:
 	 * { elements < pivot, elements == pivot, elements > pivot }
 	 */
-	pn = (char *) a + n * es;
-	r = min(pa - (char *)a, pb - pa);
+	pn = a + n * es;
+	r = min(pa - a, pb - pa);
 	vecswap(a, pb - r, r);
 	r = min((size_t) (pd - pc), (size_t) (pn - pd) - es);
 	vecswap(pb, pn - r, r);
@@ -291,6 +357,10 @@ loop:	swap_cnt = 0;
 	r = pd - pc; /* r = Size of right part. */
 	pn -= r;     /* pn = Base of right part. */
 
+	/* A badly unbalanced split spends some of the depth budget. */
+	if ((d < r ? d : r) < (n / 8) * es)
+		depth--;
+
 	/*
 	 * Check which of the left and right parts are larger.
 	 * Set (a, n)  to (base, size) of the larger part.
@@ -328,6 +398,7 @@ loop:	swap_cnt = 0;
 			 */
 			parameter_stack[recursion_level].a = a;
 			parameter_stack[recursion_level].n = n / es;
+			parameter_stack[recursion_level].depth = depth;
 			recursion_level++;
 			a = pa;
 			n = r / es;
@@ -339,13 +410,7 @@ loop:	swap_cnt = 0;
 			 * is sorted using function call recursion. The larger
 			 * part will be sorted after the function call returns.
 			 */
-#if defined(I_AM_QSORT_R)
-			__bsd_qsort_r(pa, r / es, es, thunk, cmp);
-#elif defined(I_AM_GNU_QSORT_R)
-			qsort_r(pa, r / es, es, cmp, thunk);
-#else
-			qsort(pa, r / es, es, cmp);
-#endif
+			introsort(pa, r / es, es, cmp, thunk, depth);
 		}
 	}
 	if (n > es) {  /* The larger part needs sorting. Iterate to sort.  */
@@ -358,6 +423,78 @@ pop:
 		recursion_level--;
 		a = parameter_stack[recursion_level].a;
 		n = parameter_stack[recursion_level].n;
+		depth = parameter_stack[recursion_level].depth;
 		goto loop;
 	}
 }
+
+/*
+ * Check for input which is already in order or in reverse order,
+ * reversing the latter. Both cost at most n - 1 comparisons, and
+ * the scan stops at the first element out of place.
+ */
+static int
+presorted(char *a, size_t n, size_t es, cmp_t *cmp, void *thunk __thunk_unused)
+{
+	int swaptype_swap_ulong_t, swaptype_swap_uint_t;
+	char *p, *end = a + (n - 1) * es;
+
+	if (CMP(thunk, a, a + es) <= 0) {
+		for (p = a + es; p < end; p += es)
+			if (CMP(thunk, p, p + es) > 0)
+				return 0;
+		return 1;
+	}
+	for (p = a + es; p < end; p += es)
+		if (CMP(thunk, p, p + es) <= 0)
+			return 0;
+	SWAPINIT(swap_ulong_t, a, es);
+	SWAPINIT(swap_uint_t, a, es);
+	for (p = a; p < end; p += es, end -= es) {
+		swap(p, end);
+	}
+	return 1;
+}
+
+#if defined(I_AM_QSORT_R)
+void
+__bsd_qsort_r (void *a,
+	size_t n,
+	size_t es,
+	void *thunk,
+        cmp_t *cmp);
+
+void
+__bsd_qsort_r (void *a,
+	size_t n,
+	size_t es,
+	void *thunk,
+	cmp_t *cmp)
+#elif defined(I_AM_GNU_QSORT_R)
+void
+qsort_r (void *a,
+	size_t n,
+	size_t es,
+	cmp_t *cmp,
+	void *thunk)
+#else
+void
+qsort (void *a,
+	size_t n,
+	size_t es,
+	cmp_t *cmp)
+#endif
+{
+#if !defined(I_AM_QSORT_R) && !defined(I_AM_GNU_QSORT_R)
+	void *thunk = NULL;
+#endif
+	size_t depth = 0, m;
+
+	if (n < 2)
+		return;
+	if (presorted(a, n, es, cmp, thunk))
+		return;
+	for (m = n; m > 1; m >>= 1)
+		depth++;
+	introsort(a, n, es, cmp, thunk, depth);
+}
@@ -30,7 +30,7 @@ SUCH DAMAGE.
 
 /*
  * Tree search generalized from Knuth (6.2.2) Algorithm T just like
- * the AT&T man page says.
+ * the AT&T man page says, with AVL rebalancing on the way back up.
  *
  * The node_t structure is for internal use only, lint doesn't grok it.
  *
@@ -45,10 +45,17 @@ SUCH DAMAGE.
 #endif
 
 #include <assert.h>
-#define _SEARCH_PRIVATE
-#include <search.h>
 #include <stdlib.h>
+#include "tnode.h"
 
+static void
+replace(node_t **rootp, node_t **path, unsigned char *dirs, int depth, node_t *n)
+{
+	if (depth == 0)
+		*rootp = n;
+	else
+		__tnode_set_child(path[depth - 1], dirs[depth - 1], n);
+}
 
 /* delete node with given key */
 void *
@@ -57,36 +64,82 @@ tdelete (const void *__restrict vkey,	/* key to be deleted */
 	int       (*compar)(const void *, const void *))
 {
 	node_t **rootp = (node_t **)vrootp;
-	node_t *p, *q, *r;
+	node_t *path[TNODE_MAX_DEPTH];
+	unsigned char dirs[TNODE_MAX_DEPTH];
+	node_t *n, *l, *r, *parent;
 	int  cmp;
+	int  depth = 0, target;
 
-	if (rootp == NULL || (p = *rootp) == NULL)
+	if (rootp == NULL || *rootp == NULL)
 		return NULL;
 
-	while ((cmp = (*compar)(vkey, (*rootp)->key)) != 0) {
-		p = *rootp;
-		rootp = (cmp < 0) ?
-		    &(*rootp)->llink :		/* follow llink branch */
-		    &(*rootp)->rlink;		/* follow rlink branch */
-		if (*rootp == NULL)
+	for (n = *rootp; (cmp = (*compar)(vkey, n->key)) != 0; depth++) {
+		path[depth] = n;
+		dirs[depth] = cmp > 0;
+		n = __tnode_child(n, dirs[depth]);
+		if (n == NULL)
 			return NULL;		/* key not found */
 	}
-	r = (*rootp)->rlink;			/* D1: */
-	if ((q = (*rootp)->llink) == NULL)	/* Left NULL? */
-		q = r;
-	else if (r != NULL) {			/* Right link is NULL? */
-		if (r->llink == NULL) {		/* D2: Find successor */
-			r->llink = q;
-			q = r;
-		} else {			/* D3: Find NULL link */
-			for (q = r->llink; q->llink != NULL; q = r->llink)
-				r = q;
-			r->llink = q->rlink;
-			q->llink = (*rootp)->llink;
-			q->rlink = (*rootp)->rlink;
+
+	/*
+	 * POSIX wants the parent of the deleted node; return the tree
+	 * root address when deleting the root so the caller still
+	 * sees success.
+	 */
+	parent = depth ? path[depth - 1] : (node_t *) rootp;
+
+	target = depth;
+	path[depth] = n;
+	l = __tnode_child(n, 0);
+	r = __tnode_child(n, 1);
+	if (l == NULL || r == NULL) {
+		/* At most one child, splice it into our place */
+		replace(rootp, path, dirs, depth, l ? l : r);
+	} else {
+		/*
+		 * Two children: unlink the in-order successor and put it
+		 * where n was. Moving the node rather than the key keeps
+		 * pointers handed out by tsearch valid.
+		 */
+		node_t *s;
+
+		dirs[depth++] = 1;
+		for (s = r; __tnode_child(s, 0) != NULL; s = __tnode_child(s, 0)) {
+			path[depth] = s;
+			dirs[depth++] = 0;
+		}
+		__tnode_set_child(path[depth - 1], dirs[depth - 1], __tnode_child(s, 1));
+		__tnode_set_child(s, 0, __tnode_child(n, 0));
+		__tnode_set_child(s, 1, __tnode_child(n, 1));
+		__tnode_set_balance(s, __tnode_balance(n));
+		replace(rootp, path, dirs, target, s);
+		path[target] = s;
+	}
+	free(n);
+
+	/* Walk back up while the subtree heights shrink */
+	while (depth-- > 0) {
+		int balance;
+
+		n = path[depth];
+		balance = __tnode_balance(n) - (dirs[depth] ? 1 : -1);
+		if (balance == 1 || balance == -1) {
+			__tnode_set_balance(n, balance);
+			break;
+		}
+		if (balance == 0) {
+			__tnode_set_balance(n, 0);
+			continue;
+		}
+		{
+			int heavy = balance > 0;
+			int even = __tnode_balance(__tnode_child(n, heavy)) == 0;
+
+			n = __tnode_rotate(n, heavy);
+			replace(rootp, path, dirs, depth, n);
+			if (even)
+				break;
 		}
 	}
-	free(*rootp);				/* D4: Free node */
-	*rootp = q;				/* link parent to new node */
-	return p;
+	return parent;
 }
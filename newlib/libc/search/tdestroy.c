@@ -45,9 +45,8 @@ SUCH DAMAGE.
 #endif
 
 #include <assert.h>
-#define _SEARCH_PRIVATE
-#include <search.h>
 #include <stdlib.h>
+#include "tnode.h"
 
 
 /* Walk the nodes of a tree */
@@ -57,10 +56,13 @@ trecurse(
 	void (*free_action)(void *)
 )
 {
-  if (root->llink != NULL)
-    trecurse(root->llink, free_action);
-  if (root->rlink != NULL)
-    trecurse(root->rlink, free_action);
+  node_t *l = __tnode_child(root, 0);
+  node_t *r = __tnode_child(root, 1);
+
+  if (l != NULL)
+    trecurse(l, free_action);
+  if (r != NULL)
+    trecurse(r, free_action);
 
   (*free_action) ((void *) root->key);
   free(root);
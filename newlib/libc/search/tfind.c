@@ -45,9 +45,8 @@ SUCH DAMAGE.
 #endif
 
 #include <assert.h>
-#define _SEARCH_PRIVATE
 #include <stdlib.h>
-#include <search.h>
+#include "tnode.h"
 
 /* find a node, or return 0 */
 void *
@@ -55,19 +54,17 @@ tfind (const void *vkey,		/* key to be found */
 	void **vrootp,		/* address of the tree root */
 	int (*compar)(const void *, const void *))
 {
-	node_t **rootp = (node_t **)vrootp;
+	node_t *n;
 
-	if (rootp == NULL)
+	if (vrootp == NULL)
 		return NULL;
 
-	while (*rootp != NULL) {		/* T1: */
+	for (n = *vrootp; n != NULL;) {		/* T1: */
 		int r;
 
-		if ((r = (*compar)(vkey, (*rootp)->key)) == 0)	/* T2: */
-			return *rootp;		/* key found */
-		rootp = (r < 0) ?
-		    &(*rootp)->llink :		/* T3: follow left branch */
-		    &(*rootp)->rlink;		/* T4: follow right branch */
+		if ((r = (*compar)(vkey, n->key)) == 0)	/* T2: */
+			return n;		/* key found */
+		n = __tnode_child(n, r > 0);	/* T3, T4: follow branch */
 	}
 	return NULL;
 }
@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "tnode.h"
+
+/*
+ * Rebalance a subtree whose 'dir' side is two levels taller than the
+ * other and return the new subtree root. The subtree ends up one
+ * level shorter except when the child on the tall side was evenly
+ * balanced, which only happens during deletion.
+ */
+node_t *
+__tnode_rotate(node_t *n, int dir)
+{
+	int sign = dir ? 1 : -1;
+	node_t *c = __tnode_child(n, dir);
+	int cb = __tnode_balance(c);
+
+	if (cb == -sign) {
+		/* inner grandchild is taller, double rotation */
+		node_t *g = __tnode_child(c, !dir);
+		int gb = __tnode_balance(g);
+
+		__tnode_set_child(c, !dir, __tnode_child(g, dir));
+		__tnode_set_child(n, dir, __tnode_child(g, !dir));
+		__tnode_set_child(g, dir, c);
+		__tnode_set_child(g, !dir, n);
+		__tnode_set_balance(n, gb == sign ? -sign : 0);
+		__tnode_set_balance(c, gb == -sign ? sign : 0);
+		__tnode_set_balance(g, 0);
+		return g;
+	}
+
+	__tnode_set_child(n, dir, __tnode_child(c, !dir));
+	__tnode_set_child(c, !dir, n);
+	if (cb == 0) {
+		__tnode_set_balance(n, sign);
+		__tnode_set_balance(c, -sign);
+	} else {
+		__tnode_set_balance(n, 0);
+		__tnode_set_balance(c, 0);
+	}
+	return c;
+}
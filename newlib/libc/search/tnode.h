@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * The tsearch family keeps an AVL tree. To keep node_t at three
+ * pointers, the balance of each node lives in the low bits of its
+ * links: bit 0 of llink is set when the left subtree is one level
+ * taller, bit 0 of rlink when the right subtree is. malloc always
+ * returns at least pointer-aligned blocks, so those bits are free.
+ */
+
+#ifndef _TNODE_H_
+#define _TNODE_H_
+
+#include <stdint.h>
+#include <limits.h>
+
+#define _SEARCH_PRIVATE
+#include <search.h>
+
+/*
+ * An AVL tree of height h holds at least fib(h+2)-1 nodes, so the
+ * height stays below 1.45 * log2(n). Nodes are at least 8 bytes, so
+ * n < 2**(bits-3) and 1.5 * bits is comfortably enough.
+ */
+#define TNODE_MAX_DEPTH	(sizeof(void *) * CHAR_BIT * 3 / 2)
+
+#define TNODE_HEAVY	((uintptr_t) 1)
+
+static inline node_t *
+__tnode_link(node_t *link)
+{
+	return (node_t *) ((uintptr_t) link & ~TNODE_HEAVY);
+}
+
+/* dir 0 is the left child, dir 1 the right */
+static inline node_t *
+__tnode_child(const node_t *n, int dir)
+{
+	return __tnode_link(dir ? n->rlink : n->llink);
+}
+
+static inline void
+__tnode_set_child(node_t *n, int dir, node_t *c)
+{
+	node_t **link = dir ? &n->rlink : &n->llink;
+
+	*link = (node_t *) ((uintptr_t) c | ((uintptr_t) *link & TNODE_HEAVY));
+}
+
+/* -1 when the left side is taller, 1 for the right, 0 if even */
+static inline int
+__tnode_balance(const node_t *n)
+{
+	return (int) ((uintptr_t) n->rlink & TNODE_HEAVY) -
+		(int) ((uintptr_t) n->llink & TNODE_HEAVY);
+}
+
+static inline void
+__tnode_set_balance(node_t *n, int balance)
+{
+	n->llink = (node_t *) ((uintptr_t) __tnode_link(n->llink) |
+			       (balance < 0 ? TNODE_HEAVY : 0));
+	n->rlink = (node_t *) ((uintptr_t) __tnode_link(n->rlink) |
+			       (balance > 0 ? TNODE_HEAVY : 0));
+}
+
+node_t *
+__tnode_rotate(node_t *n, int dir);
+
+#endif /* _TNODE_H_ */
@@ -30,7 +30,8 @@ SUCH DAMAGE.
 
 /*
  * Tree search generalized from Knuth (6.2.2) Algorithm T just like
- * the AT&T man page says.
+ * the AT&T man page says, kept height balanced as an AVL tree
+ * (Knuth 6.2.3) so that sorted insertions don't degrade into a list.
  *
  * The node_t structure is for internal use only, lint doesn't grok it.
  *
@@ -45,9 +46,8 @@ SUCH DAMAGE.
 #endif
 
 #include <assert.h>
-#define _SEARCH_PRIVATE
-#include <search.h>
 #include <stdlib.h>
+#include "tnode.h"
 
 /* find or insert datum into search tree */
 void *
@@ -55,29 +55,57 @@ tsearch (const void *vkey,		/* key to be located */
 	void **vrootp,		/* address of tree root */
 	int (*compar)(const void *, const void *))
 {
-	node_t *q;
 	node_t **rootp = (node_t **)vrootp;
+	node_t *path[TNODE_MAX_DEPTH];
+	unsigned char dirs[TNODE_MAX_DEPTH];
+	node_t *n, *q;
+	int depth = 0;
 
 	if (rootp == NULL)
 		return NULL;
 
-	while (*rootp != NULL) {	/* Knuth's T1: */
+	for (n = *rootp; n != NULL; n = __tnode_child(n, dirs[depth++])) {
 		int r;
 
-		if ((r = (*compar)(vkey, (*rootp)->key)) == 0)	/* T2: */
-			return *rootp;		/* we found it! */
+		if ((r = (*compar)(vkey, n->key)) == 0)
+			return n;		/* we found it! */
+		path[depth] = n;
+		dirs[depth] = r > 0;
+	}
+
+	q = malloc(sizeof(node_t));		/* key not found */
+	if (q == NULL)
+		return NULL;
+	/* LINTED const castaway ok */
+	q->key = (void *)vkey;
+	q->llink = q->rlink = NULL;
 
-		rootp = (r < 0) ?
-		    &(*rootp)->llink :		/* T3: follow left branch */
-		    &(*rootp)->rlink;		/* T4: follow right branch */
+	if (depth == 0) {
+		*rootp = q;
+		return q;
 	}
+	__tnode_set_child(path[depth - 1], dirs[depth - 1], q);
+
+	/* Walk back up while the subtree heights grow */
+	while (depth-- > 0) {
+		int balance;
 
-	q = malloc(sizeof(node_t));		/* T5: key not found */
-	if (q != 0) {				/* make new node */
-		*rootp = q;			/* link new node to old */
-		/* LINTED const castaway ok */
-		q->key = (void *)vkey;		/* initialize new node */
-		q->llink = q->rlink = NULL;
+		n = path[depth];
+		balance = __tnode_balance(n) + (dirs[depth] ? 1 : -1);
+		if (balance == 0) {
+			__tnode_set_balance(n, 0);
+			break;
+		}
+		if (balance == 1 || balance == -1) {
+			__tnode_set_balance(n, balance);
+			continue;
+		}
+		n = __tnode_rotate(n, dirs[depth]);
+		if (depth == 0)
+			*rootp = n;
+		else
+			__tnode_set_child(path[depth - 1], dirs[depth - 1], n);
+		break;
 	}
 	return q;
 }
@@ -45,9 +45,8 @@ SUCH DAMAGE.
 #endif
 
 #include <assert.h>
-#define _SEARCH_PRIVATE
-#include <search.h>
 #include <stdlib.h>
+#include "tnode.h"
 
 static void trecurse(const node_t *,
     void (*action)(const void *, VISIT, int), int level);
@@ -61,15 +60,18 @@ trecurse(
 )
 {
 
-	if (root->llink == NULL && root->rlink == NULL)
+	const node_t *l = __tnode_child(root, 0);
+	const node_t *r = __tnode_child(root, 1);
+
+	if (l == NULL && r == NULL)
 		(*action)(root, leaf, level);
 	else {
 		(*action)(root, preorder, level);
-		if (root->llink != NULL)
-			trecurse(root->llink, action, level + 1);
+		if (l != NULL)
+			trecurse(l, action, level + 1);
 		(*action)(root, postorder, level);
-		if (root->rlink != NULL)
-			trecurse(root->rlink, action, level + 1);
+		if (r != NULL)
+			trecurse(r, action, level + 1);
 		(*action)(root, endorder, level);
 	}
 }
@@ -31,7 +31,8 @@
 
 /*
  * Implement calloc by multiplying sizes (with overflow check) and
- * calling malloc (which already sets to zero)
+ * calling malloc. When malloc doesn't clear the memory, clear it
+ * here, skipping memory fresh from sbrk if that is known to be zero
  */
 
 void *
@@ -44,5 +45,20 @@ calloc(size_t n, size_t elem)
         errno = ENOMEM;
         return NULL;
     }
+#ifdef __NANO_MALLOC_CLEAR_ALLOCATED
     return malloc(bytes);
+#else
+    void *ptr;
+#ifdef MALLOC_TRACK_ZEROED
+    bool zeroed;
+
+    ptr = __malloc_alloc(bytes, &zeroed);
+    if (ptr && !zeroed)
+#else
+    ptr = malloc(bytes);
+    if (ptr)
+#endif
+        memset(ptr, '\0', bytes);
+    return ptr;
+#endif
 }
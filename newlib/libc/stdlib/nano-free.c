@@ -35,8 +35,203 @@
  *  When free, insert the to-be-freed chunk_t into free list. The place to
  *  insert should make sure all chunks are sorted by address from low to
  *  high.  Then merge with neighbor chunks if adjacent.
+ *
+ *  With __NANO_MALLOC_BINS, small chunks are pushed onto the bin
+ *  for their size instead. __malloc_bins_flush sorts the binned
+ *  chunks by address and merges them into the free list in a single
+ *  pass.
+ *
+ *  With __NANO_MALLOC_TCACHE, small chunks go to the per-thread
+ *  cache without taking the lock. When the cache list for that size
+ *  is full, it is moved to the shared bin first. The first free into
+ *  an empty cache takes the lock once to link it into __malloc_tcaches.
  */
 
+#ifdef __NANO_MALLOC_TCACHE
+
+void
+__malloc_tcache_drain(size_t b)
+{
+    chunk_t     *head = __malloc_tcache.bins[b];
+    chunk_t     *tail;
+
+    if (!head)
+        return;
+    for (tail = head; tail->next; tail = tail->next)
+        ;
+    tail->next = __malloc_bins[b];
+    __malloc_bins[b] = head;
+    __malloc_tcache.bins[b] = NULL;
+    malloc_tcache_set_count(b, 0);
+}
+
+void
+__malloc_tcache_link(void)
+{
+    MALLOC_LOCK;
+    __malloc_tcache.next = __malloc_tcaches;
+    __malloc_tcaches = &__malloc_tcache;
+    __malloc_tcache.linked = true;
+    MALLOC_UNLOCK;
+}
+
+/*
+ * Return the calling thread's cached chunks to the shared bins and
+ * remove its cache from __malloc_tcaches. This must be called before
+ * a thread exits and its thread local storage is released. A later
+ * free in the same thread links the cache in again.
+ */
+void
+__malloc_tcache_flush(void)
+{
+    struct malloc_tcache        **t;
+    size_t                      b;
+
+    MALLOC_LOCK;
+    for (b = 0; b < __NANO_MALLOC_BINS; b++)
+        __malloc_tcache_drain(b);
+    if (__malloc_tcache.linked) {
+        for (t = &__malloc_tcaches; *t; t = &(*t)->next) {
+            if (*t == &__malloc_tcache) {
+                *t = __malloc_tcache.next;
+                break;
+            }
+        }
+        __malloc_tcache.linked = false;
+    }
+    MALLOC_UNLOCK;
+}
+
+#endif
+
+#ifdef __NANO_MALLOC_BINS
+
+/* Sort a list of chunks by address */
+static chunk_t *
+__malloc_sort_chunks(chunk_t *list)
+{
+    chunk_t *a, *b, *slow, *fast, **tail;
+
+    if (!list || !list->next)
+        return list;
+
+    /* Split the list in half */
+    slow = list;
+    for (fast = list->next; fast && fast->next; fast = fast->next->next)
+        slow = slow->next;
+    b = slow->next;
+    slow->next = NULL;
+
+    a = __malloc_sort_chunks(list);
+    b = __malloc_sort_chunks(b);
+
+    /* Merge the two sorted halves */
+    tail = &list;
+    while (a && b) {
+        if (a < b) {
+            *tail = a;
+            a = a->next;
+        } else {
+            *tail = b;
+            b = b->next;
+        }
+        tail = &(*tail)->next;
+    }
+    *tail = a ? a : b;
+    return list;
+}
+
+bool
+__malloc_bins_take(chunk_t *c)
+{
+    size_t      size = _size(c);
+    chunk_t     **p, *r;
+
+    if (size < MALLOC_MINSIZE || size > MALLOC_BIN_MAXSIZE)
+        return false;
+
+#ifdef __NANO_MALLOC_TCACHE
+    size_t      b = malloc_bin_index(size);
+
+    for (p = &__malloc_tcache.bins[b]; (r = *p) != NULL; p = &r->next) {
+        if (r == c) {
+            *p = r->next;
+            malloc_tcache_set_count(b, __malloc_tcache.count[b] - 1);
+            return true;
+        }
+    }
+#endif
+
+    for (p = malloc_bin(size); (r = *p) != NULL; p = &r->next) {
+        if (r == c) {
+            *p = r->next;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+__malloc_bins_flush(void)
+{
+    chunk_t     *list = NULL, *c, *r, *prev = NULL;
+    chunk_t     **p;
+    size_t      b;
+
+    /* Gather all binned chunks into one list */
+    for (b = 0; b < __NANO_MALLOC_BINS; b++) {
+#ifdef __NANO_MALLOC_TCACHE
+        __malloc_tcache_drain(b);
+#endif
+        while ((c = __malloc_bins[b]) != NULL) {
+            __malloc_bins[b] = c->next;
+            c->next = list;
+            list = c;
+        }
+    }
+
+    if (!list)
+        return false;
+
+    list = __malloc_sort_chunks(list);
+
+    /* Merge them into the free list, joining adjacent chunks */
+    p = &__malloc_free_list;
+    while ((c = list) != NULL) {
+        list = c->next;
+
+        while ((r = *p) != NULL && r < c) {
+            prev = r;
+            p = &r->next;
+        }
+
+        /* Double free */
+        if (r == c) {
+            errno = ENOMEM;
+            continue;
+        }
+
+        if (prev && chunk_after(prev) == c) {
+            *_size_ref(prev) += _size(c);
+            c = prev;
+        } else {
+            c->next = r;
+            *p = c;
+        }
+
+        if (r && chunk_after(c) == r) {
+            *_size_ref(c) += _size(r);
+            c->next = r->next;
+        }
+
+        prev = c;
+        p = &c->next;
+    }
+    return true;
+}
+
+#endif
+
 void
 free (void * free_p)
 {
@@ -57,8 +252,55 @@ free (void * free_p)
     __malloc_validate_block(p_to_free);
 #endif
 
+#ifdef __NANO_MALLOC_TCACHE
+    if (_size(p_to_free) <= MALLOC_BIN_MAXSIZE)
+    {
+        size_t b = malloc_bin_index(_size(p_to_free));
+
+        /* Check for double free of any chunk in the cache */
+        for (r = __malloc_tcache.bins[b]; r; r = r->next)
+        {
+            if (r == p_to_free)
+            {
+                errno = ENOMEM;
+                return;
+            }
+        }
+
+        if (!__malloc_tcache.linked)
+            __malloc_tcache_link();
+
+        if (__malloc_tcache.count[b] >= __NANO_MALLOC_TCACHE)
+        {
+            MALLOC_LOCK;
+            __malloc_tcache_drain(b);
+            MALLOC_UNLOCK;
+        }
+        p_to_free->next = __malloc_tcache.bins[b];
+        __malloc_tcache.bins[b] = p_to_free;
+        malloc_tcache_set_count(b, __malloc_tcache.count[b] + 1);
+        return;
+    }
+#endif
+
     MALLOC_LOCK;
 
+#ifdef __NANO_MALLOC_BINS
+    if (_size(p_to_free) <= MALLOC_BIN_MAXSIZE)
+    {
+        p = malloc_bin(_size(p_to_free));
+
+        /* Check for double free of the most recently binned chunk */
+        if (*p == p_to_free)
+            errno = ENOMEM;
+        else {
+            p_to_free->next = *p;
+            *p = p_to_free;
+        }
+        goto unlock;
+    }
+#endif
+
     for (p = &__malloc_free_list; (r = *p) != NULL; p = &r->next)
     {
 	/* Insert in address order */
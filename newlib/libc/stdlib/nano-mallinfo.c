@@ -51,11 +51,30 @@ mallinfo(void)
             total_size = (size_t) (sbrk_now - __malloc_sbrk_start);
     }
 
+#ifdef __NANO_MALLOC_BINS
+    /* Merge binned chunks so the free block counts are accurate */
+    __malloc_bins_flush();
+#endif
+
     for (pf = __malloc_free_list; pf; pf = pf->next) {
 	ordblks++;
         free_size += _size(pf);
     }
 
+#ifdef __NANO_MALLOC_TCACHE
+    /* Count chunks cached by other threads as free */
+    struct malloc_tcache *t;
+    size_t b;
+
+    for (t = __malloc_tcaches; t; t = t->next) {
+        for (b = 0; b < __NANO_MALLOC_BINS; b++) {
+            size_t count = malloc_tcache_count(t, b);
+            ordblks += count;
+            free_size += count * (MALLOC_MINSIZE + b * MALLOC_HEAD_ALIGN);
+        }
+    }
+#endif
+
     current_mallinfo.ordblks = ordblks;
     current_mallinfo.arena = total_size;
     current_mallinfo.fordblks = free_size;
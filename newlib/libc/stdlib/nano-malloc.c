@@ -31,6 +31,19 @@
 /* List list header of free blocks */
 chunk_t *__malloc_free_list;
 
+#ifdef __NANO_MALLOC_BINS
+/* Exact-size lists of small free blocks */
+chunk_t *__malloc_bins[__NANO_MALLOC_BINS];
+#endif
+
+#ifdef __NANO_MALLOC_TCACHE
+/* Per-thread lists of small free blocks */
+__THREAD_LOCAL struct malloc_tcache __malloc_tcache;
+
+/* Per-thread caches which may hold chunks */
+struct malloc_tcache *__malloc_tcaches;
+#endif
+
 /* Starting point of memory allocated from system */
 char * __malloc_sbrk_start;
 char * __malloc_sbrk_top;
@@ -126,14 +139,35 @@ __malloc_grow_chunk(chunk_t *c, size_t new_size)
   * Algorithm:
   *   Walk through the free list to find the first match. If fails to find
   *   one, call sbrk to allocate a new chunk_t.
+  *
+  *   Unless __NANO_MALLOC_CLEAR_ALLOCATED is defined, the returned
+  *   memory is not cleared; calloc does that itself.
+  *
+  *   With __NANO_MALLOC_BINS, small requests are first served from the
+  *   smallest non-empty bin which fits, splitting the chunk if
+  *   needed. Before calling sbrk, any binned chunks are merged back
+  *   into the free list and the search is repeated.
+  *
+  *   With __NANO_MALLOC_TCACHE, small requests which exactly match a
+  *   chunk in the per-thread cache are served from there without
+  *   taking the lock.
   */
+#ifdef MALLOC_TRACK_ZEROED
+void *
+__malloc_alloc(size_t s, bool *zeroed)
+#else
 void *
 malloc(size_t s)
+#endif
 {
     chunk_t **p, *r;
     char * ptr;
     size_t alloc_size;
 
+#ifdef MALLOC_TRACK_ZEROED
+    *zeroed = false;
+#endif
+
     if (s > MALLOC_MAXSIZE)
     {
         errno = ENOMEM;
@@ -142,8 +176,52 @@ malloc(size_t s)
 
     alloc_size = chunk_size(s);
 
+#ifdef __NANO_MALLOC_TCACHE
+    if (alloc_size <= MALLOC_BIN_MAXSIZE)
+    {
+        size_t b = malloc_bin_index(alloc_size);
+
+        if ((r = __malloc_tcache.bins[b]) != NULL)
+        {
+            __malloc_tcache.bins[b] = r->next;
+            malloc_tcache_set_count(b, __malloc_tcache.count[b] - 1);
+            goto cached;
+        }
+    }
+#endif
+
     MALLOC_LOCK;
 
+#ifdef __NANO_MALLOC_BINS
+    if (alloc_size <= MALLOC_BIN_MAXSIZE)
+    {
+        for (p = malloc_bin(alloc_size); p < &__malloc_bins[__NANO_MALLOC_BINS]; p++)
+        {
+            if ((r = *p) != NULL)
+            {
+                size_t rem = _size(r) - alloc_size;
+
+                /* Skip bins too small to split */
+                if (rem && rem < MALLOC_MINSIZE)
+                    continue;
+
+                *p = r->next;
+                if (rem)
+                {
+                    /* Return the tail to the bin for its size */
+                    chunk_t *s = (chunk_t *)((char *)r + alloc_size);
+                    chunk_t **b = malloc_bin(rem);
+                    _set_size(s, rem);
+                    s->next = *b;
+                    *b = s;
+                    _set_size(r, alloc_size);
+                }
+                goto found;
+            }
+        }
+    }
+retry:
+#endif
     for (p = &__malloc_free_list; (r = *p) != NULL; p = &r->next)
     {
         if (_size(r) >= alloc_size)
@@ -185,6 +263,10 @@ malloc(size_t s)
     /* Failed to find a appropriate chunk_t. Ask for more memory */
     if (r == NULL)
     {
+#ifdef __NANO_MALLOC_BINS
+        if (__malloc_bins_flush())
+            goto retry;
+#endif
         void *blob = __malloc_sbrk_aligned(alloc_size);
 
         /* sbrk returns -1 if fail to allocate */
@@ -196,17 +278,38 @@ malloc(size_t s)
         }
         r = blob_to_chunk(blob);
         _set_size(r, alloc_size);
+#ifdef MALLOC_TRACK_ZEROED
+        *zeroed = true;
+#endif
     }
 
+#ifdef __NANO_MALLOC_BINS
+found:
+#endif
     MALLOC_UNLOCK;
 
+#ifdef __NANO_MALLOC_TCACHE
+cached:
+#endif
     ptr = chunk_to_ptr(r);
 
+#ifdef __NANO_MALLOC_CLEAR_ALLOCATED
     memset(ptr, '\0', alloc_size - MALLOC_HEAD);
+#endif
 
     return ptr;
 }
 
+#ifdef MALLOC_TRACK_ZEROED
+void *
+malloc(size_t s)
+{
+    bool zeroed;
+
+    return __malloc_alloc(s, &zeroed);
+}
+#endif
+
 #ifdef __strong_reference
 #if defined(__GNUCLIKE_PRAGMA_DIAGNOSTIC) && !defined(__clang__)
 #pragma GCC diagnostic ignored "-Wmissing-attributes"
@@ -237,6 +340,27 @@ __malloc_validate(void)
 	__malloc_validate_block(r);
 	assert (r->next == NULL || (char *) r + _size(r) <= (char *) r->next);
     }
+#ifdef __NANO_MALLOC_BINS
+    size_t b;
+
+    for (b = 0; b < __NANO_MALLOC_BINS; b++) {
+        for (r = __malloc_bins[b]; r; r = r->next) {
+            __malloc_validate_block(r);
+            assert (malloc_bin(_size(r)) == &__malloc_bins[b]);
+        }
+    }
+#endif
+#ifdef __NANO_MALLOC_TCACHE
+    for (b = 0; b < __NANO_MALLOC_BINS; b++) {
+        size_t count = 0;
+        for (r = __malloc_tcache.bins[b]; r; r = r->next) {
+            __malloc_validate_block(r);
+            assert (malloc_bin_index(_size(r)) == b);
+            count++;
+        }
+        assert (count == __malloc_tcache.count[b]);
+    }
+#endif
 }
 
 #endif
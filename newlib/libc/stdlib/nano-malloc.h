@@ -44,18 +44,6 @@
 #include <sys/param.h>
 #include <stdint.h>
 
-#if MALLOC_DEBUG
-void __malloc_validate(void);
-void __malloc_validate_block(chunk_t *r);
-#define MALLOC_LOCK do { __LIBC_LOCK(); __malloc_validate(); } while(0)
-#define MALLOC_UNLOCK do { __malloc_validate(); __LIBC_UNLOCK(); } while(0)
-#else
-#define __malloc_validate()
-#define __malloc_validate_block(r)
-#define MALLOC_LOCK __LIBC_LOCK()
-#define MALLOC_UNLOCK __LIBC_UNLOCK()
-#endif
-
 #if __STDC_VERSION__ >= 201112L
 typedef max_align_t align_chunk_t;
 #else
@@ -95,6 +83,18 @@ typedef struct malloc_chunk {
     struct malloc_chunk *next;
 } chunk_t;
 
+#if MALLOC_DEBUG
+void __malloc_validate(void);
+void __malloc_validate_block(chunk_t *r);
+#define MALLOC_LOCK do { __LIBC_LOCK(); __malloc_validate(); } while(0)
+#define MALLOC_UNLOCK do { __malloc_validate(); __LIBC_UNLOCK(); } while(0)
+#else
+#define __malloc_validate()
+#define __malloc_validate_block(r)
+#define MALLOC_LOCK __LIBC_LOCK()
+#define MALLOC_UNLOCK __LIBC_UNLOCK()
+#endif
+
 /* Alignment of allocated chunk. Compute the alignment required from a
  * range of types */
 #define MALLOC_CHUNK_ALIGN	_Alignof(align_chunk_t)
@@ -142,6 +142,109 @@ extern char * __malloc_sbrk_top;
 
 bool __malloc_grow_chunk(chunk_t *c, size_t new_size);
 
+/*
+ * When malloc doesn't clear memory, calloc does. If sbrk is known
+ * to return zero-filled memory, chunks fresh from sbrk don't need
+ * clearing, so malloc reports those to calloc.
+ */
+#if !defined(__NANO_MALLOC_CLEAR_ALLOCATED) && defined(__NANO_MALLOC_SBRK_ZEROED)
+#define MALLOC_TRACK_ZEROED
+void *__malloc_alloc(size_t s, bool *zeroed);
+#endif
+
+#if defined(__NANO_MALLOC_TCACHE) && !defined(__NANO_MALLOC_BINS)
+#error nano-malloc per-thread caches require __NANO_MALLOC_BINS
+#endif
+
+#ifdef __NANO_MALLOC_BINS
+
+/*
+ * Segregated free lists. Small chunks are kept in exact-size bins
+ * in front of the address-ordered free list, one bin per
+ * MALLOC_HEAD_ALIGN step starting at MALLOC_MINSIZE. Small requests
+ * take the first chunk from the smallest non-empty bin that fits.
+ * Chunks in the bins are not merged with their neighbors until
+ * __malloc_bins_flush moves them back to the address-ordered list,
+ * which happens before asking sbrk for more memory and when
+ * computing mallinfo.
+ */
+
+#define MALLOC_BIN_MAXSIZE	(MALLOC_MINSIZE + (__NANO_MALLOC_BINS - 1) * MALLOC_HEAD_ALIGN)
+
+extern chunk_t *__malloc_bins[__NANO_MALLOC_BINS];
+
+/* index of bin holding chunks of 'size' bytes. size must be <= MALLOC_BIN_MAXSIZE */
+static inline size_t
+malloc_bin_index(size_t size)
+{
+    return (size - MALLOC_MINSIZE) / MALLOC_HEAD_ALIGN;
+}
+
+/* bin holding chunks of 'size' bytes. size must be <= MALLOC_BIN_MAXSIZE */
+static inline chunk_t **
+malloc_bin(size_t size)
+{
+    return &__malloc_bins[malloc_bin_index(size)];
+}
+
+/* Move all binned chunks to the address-ordered list. Returns
+ * true if any chunks were moved */
+bool __malloc_bins_flush(void);
+
+/* Remove 'c' from its bin or the calling thread's cache. Returns
+ * true if it was found there */
+bool __malloc_bins_take(chunk_t *c);
+
+#ifdef __NANO_MALLOC_TCACHE
+
+/*
+ * Per-thread caches. Each thread keeps up to __NANO_MALLOC_TCACHE
+ * recently freed chunks for each bin size in thread local storage,
+ * which malloc and free use without taking the malloc lock. When a
+ * cache list fills up, it is moved to the shared bin. The calling
+ * thread's cache is also moved to the shared bins by
+ * __malloc_bins_flush and __malloc_tcache_flush.
+ *
+ * Caches holding chunks are linked together so that mallinfo can
+ * count the chunks cached by other threads as free. Only the owning
+ * thread touches the lists; the counts are read with relaxed atomics.
+ */
+
+struct malloc_tcache {
+    chunk_t                     *bins[__NANO_MALLOC_BINS];
+    uint8_t                     count[__NANO_MALLOC_BINS];
+    struct malloc_tcache        *next;
+    bool                        linked;
+};
+
+extern __THREAD_LOCAL struct malloc_tcache __malloc_tcache;
+
+/* All caches which may hold chunks. Protected by the malloc lock */
+extern struct malloc_tcache *__malloc_tcaches;
+
+static inline uint8_t
+malloc_tcache_count(struct malloc_tcache *tcache, size_t b)
+{
+    return __atomic_load_n(&tcache->count[b], __ATOMIC_RELAXED);
+}
+
+static inline void
+malloc_tcache_set_count(size_t b, uint8_t count)
+{
+    __atomic_store_n(&__malloc_tcache.count[b], count, __ATOMIC_RELAXED);
+}
+
+/* Move one per-thread cache list to the shared bin. Called with the
+ * malloc lock held */
+void __malloc_tcache_drain(size_t b);
+
+/* Add the calling thread's cache to __malloc_tcaches */
+void __malloc_tcache_link(void);
+
+#endif
+
+#endif
+
 /* Work around compiler optimizing away stores to 'size' field before
  * call to free.
  */
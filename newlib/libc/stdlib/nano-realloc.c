@@ -72,29 +72,50 @@ realloc(void * ptr, size_t size)
 
 	if (__malloc_grow_chunk(p_to_realloc, new_size))
 	{
+#ifdef __NANO_MALLOC_CLEAR_ALLOCATED
 	    /* clear new memory */
 	    memset(chunk_e, '\0', new_size - old_size);
+#endif
 	    /* adjust chunk_t size */
 	    old_size = new_size;
 	}
 	else
 	{
 	    chunk_t **p, *r;
+	    chunk_t *next = chunk_after(p_to_realloc);
+
+#ifdef __NANO_MALLOC_BINS
+	    /* The chunk_t just past the current block may be sitting
+	     * in a bin instead of the free list, merge it in from there
+	     */
+	    if ((char *) chunk_e < __malloc_sbrk_top && __malloc_bins_take(next))
+	    {
+		size_t r_size = _size(next);
 
+#ifdef __NANO_MALLOC_CLEAR_ALLOCATED
+		memset(chunk_e, '\0', r_size);
+#endif
+		old_size += r_size;
+		_set_size(p_to_realloc, old_size);
+	    }
+	    else
+#endif
 	    /* Check to see if there's a chunk_t of free space just past
 	     * the current block, merge it in in case that's useful
 	     */
 	    for (p = &__malloc_free_list; (r = *p) != NULL; p = &r->next)
 	    {
-		if (r == chunk_e)
+		if (r == next)
 		{
 		    size_t r_size = _size(r);
 
 		    /* remove R from the free list */
 		    *p = r->next;
 
-		    /* clear the memory from r */
-		    memset(r, '\0', r_size);
+#ifdef __NANO_MALLOC_CLEAR_ALLOCATED
+		    /* clear the memory from r, including its header */
+		    memset(chunk_e, '\0', r_size);
+#endif
 
 		    /* add it's size to our block */
 		    old_size += r_size;
@@ -48,23 +48,28 @@ localtime_r (const time_t *__restrict tim_p,
 
   TZ_LOCK;
   _tzset_unlocked ();
-  if (_daylight)
+#ifdef __TZIF
+  if ((res->tm_isdst = __tzif_localtime (*tim_p, &offset)) < 0)
+#endif
     {
-      if (year == tz->__tzyear || __tzcalc_limits (year))
-	res->tm_isdst = (tz->__tznorth
-	  ? (*tim_p >= tz->__tzrule[0].change
-	  && *tim_p < tz->__tzrule[1].change)
-	  : (*tim_p >= tz->__tzrule[0].change
-	  || *tim_p < tz->__tzrule[1].change));
+      if (_daylight)
+	{
+	  if (year == tz->__tzyear || __tzcalc_limits (year))
+	    res->tm_isdst = (tz->__tznorth
+	      ? (*tim_p >= tz->__tzrule[0].change
+	      && *tim_p < tz->__tzrule[1].change)
+	      : (*tim_p >= tz->__tzrule[0].change
+	      || *tim_p < tz->__tzrule[1].change));
+	  else
+	    res->tm_isdst = -1;
+	}
       else
-	res->tm_isdst = -1;
-    }
-  else
-    res->tm_isdst = 0;
+	res->tm_isdst = 0;
 
-  offset = (res->tm_isdst == 1
-    ? tz->__tzrule[1].offset
-    : tz->__tzrule[0].offset);
+      offset = (res->tm_isdst == 1
+	? tz->__tzrule[1].offset
+	: tz->__tzrule[0].offset);
+    }
 
   hours = (int) (offset / SECSPERHOUR);
   offset = offset % SECSPERHOUR;
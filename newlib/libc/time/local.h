@@ -36,6 +36,13 @@ extern const uint8_t __month_lengths[2][MONSPERYEAR];
 
 void _tzset_unlocked (void);
 
+#ifdef __TZIF
+const char *__tzif_load (const char *tzenv);
+int __tzif_localtime (time_t t, long *offset);
+int __tzif_mktime (time_t tim, int isdst, long *offset, long *diff);
+int __tzif_zone (time_t tim, int isdst, long *offset, const char **abbr);
+#endif
+
 /* locks for multi-threading */
 #define TZ_LOCK		__LIBC_LOCK()
 #define TZ_UNLOCK	__LIBC_UNLOCK()
@@ -227,6 +227,36 @@ mktime_utc (struct tm *tim_p, long *days_p)
   return tim;
 }
 
+/* move the structure by diff seconds when the offset in effect changes */
+static void
+shift_structure (struct tm *tim_p, int diff, long *days_p, int *year_p)
+{
+  int mday = tim_p->tm_mday;
+
+  tim_p->tm_sec += diff;
+  validate_structure (tim_p);
+  mday = tim_p->tm_mday - mday;
+  /* roll over occurred */
+  if (mday) {
+    /* compensate for month roll overs */
+    if (mday > 1)
+	  mday = -1;
+    else if (mday < -1)
+	  mday = 1;
+    /* update days for wday calculation */
+    *days_p += mday;
+    /* handle yday */
+    if ((tim_p->tm_yday += mday) < 0) {
+	  --*year_p;
+	  tim_p->tm_yday = _DAYS_IN_YEAR(*year_p) - 1;
+    } else {
+	  mday = _DAYS_IN_YEAR(*year_p);
+	  if (tim_p->tm_yday > (mday - 1))
+		tim_p->tm_yday -= mday;
+    }
+  }
+}
+
 time_t
 mktime (struct tm *tim_p)
 {
@@ -235,6 +265,10 @@ mktime (struct tm *tim_p)
   int year;
   int isdst=0;
   __tzinfo_type *tz;
+#ifdef __TZIF
+  int tzif_isdst;
+  long tzif_offset, tzif_diff;
+#endif
 
   tim = mktime_utc (tim_p, &days);
 
@@ -249,6 +283,19 @@ mktime (struct tm *tim_p)
 
   _tzset_unlocked ();
 
+#ifdef __TZIF
+  tzif_isdst = __tzif_mktime (tim, tim_p->tm_isdst, &tzif_offset, &tzif_diff);
+  if (tzif_isdst >= 0)
+    {
+      isdst = tzif_isdst;
+      if (tzif_diff)
+	{
+	  tim += tzif_diff;
+	  shift_structure (tim_p, (int) tzif_diff, &days, &year);
+	}
+    }
+  else
+#endif
   if (_daylight)
     {
       int tm_isdst;
@@ -289,36 +336,19 @@ mktime (struct tm *tim_p)
 				    - tz->__tzrule[1].offset);
 		  if (!isdst)
 		    diff = -diff;
-		  tim_p->tm_sec += diff;
 		  tim += diff;  /* we also need to correct our current time calculation */
-		  int mday = tim_p->tm_mday;
-		  validate_structure (tim_p);
-		  mday = tim_p->tm_mday - mday;
-		  /* roll over occurred */
-		  if (mday) {
-		    /* compensate for month roll overs */
-		    if (mday > 1)
-			  mday = -1;
-		    else if (mday < -1)
-			  mday = 1;
-		    /* update days for wday calculation */
-		    days += mday;
-		    /* handle yday */
-		    if ((tim_p->tm_yday += mday) < 0) {
-			  --year;
-			  tim_p->tm_yday = _DAYS_IN_YEAR(year) - 1;
-		    } else {
-			  mday = _DAYS_IN_YEAR(year);
-			  if (tim_p->tm_yday > (mday - 1))
-				tim_p->tm_yday -= mday;
-		    }
-		  }
+		  shift_structure (tim_p, diff, &days, &year);
 		}
 	    }
 	}
     }
 
   /* add appropriate offset to put time in gmt format */
+#ifdef __TZIF
+  if (tzif_isdst >= 0)
+    tim += (time_t) tzif_offset;
+  else
+#endif
   if (isdst == 1)
     tim += (time_t) tz->__tzrule[1].offset;
   else /* otherwise assume std time */
@@ -349,6 +349,32 @@ locale, hard-coding the "C" locale settings.
 #  error "YEAR_BASE < 0"
 #endif
 
+#ifdef __TZIF
+/* Look up the UTC offset (east of UTC, unlike TZ) and time zone
+   designation in TZif data for the local time in TIM_P.  The footer
+   rule in __tzrule only describes times after the transition table.
+   Returns 0 when the footer rule applies.  */
+static int
+tzif_zone (const struct tm *tim_p, long *offset, const char **abbr)
+{
+  long long tim = (((((long long)tim_p->tm_year - 69)/4
+		     - (tim_p->tm_year - 1)/100
+		     + (tim_p->tm_year + 299)/400
+		     + (tim_p->tm_year - 70)*365 + tim_p->tm_yday)*24
+		    + tim_p->tm_hour)*60 + tim_p->tm_min)*60 + tim_p->tm_sec;
+  const char *name;
+  long off;
+
+  if (!__tzif_zone ((time_t) tim, tim_p->tm_isdst, &off, &name))
+    return 0;
+  if (offset)
+    *offset = -off;
+  if (abbr)
+    *abbr = name;
+  return 1;
+}
+#endif
+
 /* Using the tm_year, tm_wday, and tm_yday components of TIM_P, return
    -1, 0, or 1 as the adjustment to add to the year for the ISO week
    numbering used in "%g%G%V", avoiding overflow.  */
@@ -1150,6 +1176,9 @@ recurse:
 		/* The sign of this is exactly opposite the envvar TZ.  We
 		   could directly use the global _timezone for tm_isdst==0,
 		   but have to use __tzrule for daylight savings.  */
+#ifdef __TZIF
+		if (!tzif_zone (tim_p, &offset, NULL))
+#endif
 		offset = -tz->__tzrule[tim_p->tm_isdst > 0].offset;
 #endif
 		TZ_UNLOCK;
@@ -1385,6 +1414,9 @@ recurse:
 	      /* The sign of this is exactly opposite the envvar TZ.  We
 		 could directly use the global _timezone for tm_isdst==0,
 		 but have to use __tzrule for daylight savings.  */
+#ifdef __TZIF
+	      if (!tzif_zone (tim_p, &offset, NULL))
+#endif
 	      offset = -tz->__tzrule[tim_p->tm_isdst > 0].offset;
 #endif
 	      TZ_UNLOCK;
@@ -1408,6 +1440,8 @@ recurse:
 		}
 #if   defined (__TM_ZONE)
 	      tznam = tim_p->__TM_ZONE;
+#elif defined (__TZIF)
+	      tzif_zone (tim_p, NULL, &tznam);
 #endif
 	      if (!tznam)
 		tznam = tzname[tim_p->tm_isdst > 0];
@@ -23,6 +23,21 @@ __tzcalc_limits (int year)
 
   tz->__tzyear = year;
 
+#if __TZ_YEAR_CACHE > 0
+  for (i = 0; i < __TZ_YEAR_CACHE; ++i)
+    {
+      const __tzyear_type *const c = &tz->__tzcache[i];
+
+      if (c->year == year)
+	{
+	  tz->__tzrule[0].change = c->change[0];
+	  tz->__tzrule[1].change = c->change[1];
+	  tz->__tznorth = c->north;
+	  return 1;
+	}
+    }
+#endif
+
   years = (year - EPOCH_YEAR);
 
   year_days = years * 365 +
@@ -73,5 +88,17 @@ __tzcalc_limits (int year)
 
   tz->__tznorth = (tz->__tzrule[0].change < tz->__tzrule[1].change);
 
+#if __TZ_YEAR_CACHE > 0
+  {
+    __tzyear_type *const c = &tz->__tzcache[tz->__tzcache_next];
+
+    c->year = year;
+    c->north = tz->__tznorth;
+    c->change[0] = tz->__tzrule[0].change;
+    c->change[1] = tz->__tzrule[1].change;
+    tz->__tzcache_next = (tz->__tzcache_next + 1) % __TZ_YEAR_CACHE;
+  }
+#endif
+
   return 1;
 }
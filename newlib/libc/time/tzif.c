@@ -0,0 +1,507 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * TZif (RFC 8536) time zone data for tzset, localtime and mktime.
+ *
+ * The transition table is used where it is stored: in the linked-in
+ * image, or in a buffer holding the file named by TZ=:path. Lookups
+ * binary search the big-endian transition times directly. Times after
+ * the last transition are left to the POSIX rule in the footer, which
+ * tzset parses like any other TZ value.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include "local.h"
+
+#ifdef __TZIF
+
+#define TZIF_HEADER	44	/* magic, version, reserved, six counts */
+#define TZIF_TTINFO	6	/* utoff, isdst, desigidx */
+#define TZIF_FILE_MAX	65536
+#define TZIF_RULE_MAX	64
+#define TZIF_SLOP	(26 * SECSPERHOUR)	/* largest |utoff| allowed */
+
+/* An application may link in a TZif image to use when TZ is unset */
+extern const unsigned char __tzif_builtin[] __weak;
+extern const size_t __tzif_builtin_size __weak;
+
+/* Only needed to read TZ=:path */
+int open (const char *, int, ...) __weak;
+ssize_t read (int, void *, size_t) __weak;
+int close (int) __weak;
+
+static struct {
+  const unsigned char *times;	/* transition times */
+  const unsigned char *types;	/* time type from each transition on */
+  const unsigned char *ttinfo;	/* time types */
+  const char *abbrs;		/* time zone designations */
+  uint32_t timecnt;
+  uint8_t tsize;		/* 4 for version 1 data, else 8 */
+  bool rule;			/* the footer covers times after the table */
+  bool rule_known;		/* rule_from has been computed */
+  bool valid;
+  int64_t rule_from;		/* first time the footer rule applies */
+} tzif;
+
+static unsigned char *tzif_file;
+static char *tzif_name;
+static char tzif_rule[TZIF_RULE_MAX];
+
+static uint32_t
+tzif_u32 (const unsigned char *p)
+{
+  return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) |
+    ((uint32_t) p[2] << 8) | p[3];
+}
+
+static int64_t
+tzif_time (uint32_t i)
+{
+  const unsigned char *p = tzif.times + (size_t) i * tzif.tsize;
+
+  if (tzif.tsize == 4)
+    return (int32_t) tzif_u32 (p);
+  return (int64_t) (((uint64_t) tzif_u32 (p) << 32) | tzif_u32 (p + 4));
+}
+
+/* Index of the last transition at or before t, -1 if there is none */
+static int32_t
+tzif_find (int64_t t)
+{
+  uint32_t lo = 0, hi = tzif.timecnt;
+
+  while (lo < hi)
+    {
+      uint32_t mid = lo + (hi - lo) / 2;
+
+      if (tzif_time (mid) <= t)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  return (int32_t) lo - 1;
+}
+
+/* Time type in effect from transition k until the next one */
+static const unsigned char *
+tzif_ttinfo (int32_t k)
+{
+  return tzif.ttinfo + TZIF_TTINFO * (k < 0 ? 0 : tzif.types[k]);
+}
+
+static long
+tzif_utoff (int32_t k)
+{
+  return (int32_t) tzif_u32 (tzif_ttinfo (k));
+}
+
+static int
+tzif_isdst (int32_t k)
+{
+  return tzif_ttinfo (k)[4] != 0;
+}
+
+/*
+ * The last time type holds until the footer rule next changes the
+ * offset, which may be later than the last transition when the rule
+ * for that year would disagree with it.
+ */
+static int64_t
+tzif_rule_from (void)
+{
+  __tzinfo_type *const tz = __gettzinfo ();
+  time_t last;
+  struct tm tm;
+  int64_t from;
+  int year, i;
+
+  if (tzif.rule_known)
+    return tzif.rule_from;
+  tzif.rule_known = true;
+  if (tzif.timecnt == 0)
+    return tzif.rule_from = INT64_MIN;
+  last = (time_t) tzif_time (tzif.timecnt - 1);
+  from = INT64_MAX;
+  if (_daylight && gmtime_r (&last, &tm))
+    for (year = tm.tm_year + YEAR_BASE; year <= tm.tm_year + YEAR_BASE + 1; year++)
+      if (__tzcalc_limits (year))
+	for (i = 0; i < 2; i++)
+	  if (tz->__tzrule[i].change >= last && tz->__tzrule[i].change < from)
+	    from = tz->__tzrule[i].change;
+  if (from == INT64_MAX)
+    from = last;
+  return tzif.rule_from = from;
+}
+
+static bool
+tzif_by_rule (int32_t k, int64_t t)
+{
+  return tzif.rule && k == (int32_t) tzif.timecnt - 1 && t >= tzif_rule_from ();
+}
+
+/* Does the UTC time of local time tim, read with interval k's offset, fall in k? */
+static bool
+tzif_in (int32_t k, int64_t tim)
+{
+  int64_t t = tim - tzif_utoff (k);
+
+  return (k < 0 || t >= tzif_time (k)) &&
+    (k + 1 >= (int32_t) tzif.timecnt || t < tzif_time (k + 1));
+}
+
+static char *
+tzif_digits (char *s, unsigned long v, int width)
+{
+  if (v >= 10 || width > 1)
+    s = tzif_digits (s, v / 10, width - 1);
+  *s++ = '0' + v % 10;
+  return s;
+}
+
+/*
+ * Without a footer the table covers all times. Give tzset a rule
+ * naming the last time type so tzname and _timezone are still set.
+ */
+static void
+tzif_last_type (void)
+{
+  const unsigned char *tt = tzif_ttinfo ((int32_t) tzif.timecnt - 1);
+  const char *abbr = tzif.abbrs + tt[5];
+  long utoff = (int32_t) tzif_u32 (tt);
+  unsigned long off;
+  size_t len = strlen (abbr);
+  char *s = tzif_rule;
+
+  if (len > TZNAME_MAX)
+    len = TZNAME_MAX;
+  *s++ = '<';
+  memcpy (s, abbr, len);
+  s += len;
+  *s++ = '>';
+  /* POSIX offsets are added to local time to get UTC */
+  if (utoff > 0)
+    *s++ = '-';
+  off = utoff < 0 ? -utoff : utoff;
+  s = tzif_digits (s, off / SECSPERHOUR, 1);
+  *s++ = ':';
+  s = tzif_digits (s, off / SECSPERMIN % MINSPERHOUR, 2);
+  *s++ = ':';
+  s = tzif_digits (s, off % SECSPERMIN, 2);
+  *s = '\0';
+}
+
+static bool
+tzif_parse (const unsigned char *p, size_t len)
+{
+  const unsigned char *data, *end;
+  uint32_t isutcnt, isstdcnt, leapcnt, timecnt, typecnt, charcnt, i;
+  size_t size;
+  uint8_t tsize = 4;
+
+  for (;;)
+    {
+      if (len < TZIF_HEADER || memcmp (p, "TZif", 4) != 0)
+	return false;
+      isutcnt = tzif_u32 (p + 20);
+      isstdcnt = tzif_u32 (p + 24);
+      leapcnt = tzif_u32 (p + 28);
+      timecnt = tzif_u32 (p + 32);
+      typecnt = tzif_u32 (p + 36);
+      charcnt = tzif_u32 (p + 40);
+      len -= TZIF_HEADER;
+      if (typecnt == 0 || typecnt > 256 || charcnt == 0 ||
+	  timecnt > len || leapcnt > len || charcnt > len ||
+	  isstdcnt > typecnt || isutcnt > typecnt)
+	return false;
+      size = (size_t) timecnt * (tsize + 1) + (size_t) typecnt * TZIF_TTINFO +
+	charcnt + (size_t) leapcnt * (tsize + 4) + isstdcnt + isutcnt;
+      if (size > len)
+	return false;
+      /* Version 2 and later repeat the data with 64-bit times */
+      if (tsize == 4 && p[4] >= '2')
+	{
+	  p += TZIF_HEADER + size;
+	  len -= size;
+	  tsize = 8;
+	  continue;
+	}
+      break;
+    }
+
+  data = p + TZIF_HEADER;
+  end = data + len;
+  tzif.times = data;
+  tzif.types = data + (size_t) timecnt * tsize;
+  tzif.ttinfo = tzif.types + timecnt;
+  tzif.abbrs = (const char *) tzif.ttinfo + (size_t) typecnt * TZIF_TTINFO;
+  tzif.timecnt = timecnt;
+  tzif.tsize = tsize;
+
+  if (tzif.abbrs[charcnt - 1] != '\0')
+    return false;
+  /* Lookups binary search the transitions, which must be in order */
+  for (i = 0; i < timecnt; i++)
+    if (tzif.types[i] >= typecnt ||
+	(i > 0 && tzif_time (i) <= tzif_time (i - 1)))
+      return false;
+  for (i = 0; i < typecnt; i++)
+    if (tzif.ttinfo[i * TZIF_TTINFO + 5] >= charcnt ||
+	labs ((int32_t) tzif_u32 (tzif.ttinfo + i * TZIF_TTINFO)) >= TZIF_SLOP)
+      return false;
+
+  /* Leap second records are skipped; times are taken as POSIX times */
+  tzif.rule = false;
+  p = data + size;
+  if (tsize == 8 && p < end)
+    {
+      const unsigned char *nl;
+
+      if (*p++ != '\n' || (nl = memchr (p, '\n', end - p)) == NULL)
+	return false;
+      /* An empty footer leaves the last time type in effect */
+      if (nl > p)
+	{
+	  /* Dropping a longer rule would give wrong times after the table */
+	  if ((size_t) (nl - p) >= sizeof (tzif_rule))
+	    return false;
+	  memcpy (tzif_rule, p, nl - p);
+	  tzif_rule[nl - p] = '\0';
+	  tzif.rule = true;
+	}
+    }
+  if (!tzif.rule)
+    tzif_last_type ();
+  return true;
+}
+
+static unsigned char *
+tzif_read (const char *path, size_t *lenp)
+{
+  unsigned char *buf = NULL, *n;
+  size_t len = 0, size = 0;
+  ssize_t r;
+  int fd;
+
+  if (!open || !read || !close)
+    return NULL;
+  fd = open (path, O_RDONLY);
+  if (fd < 0)
+    return NULL;
+  for (;;)
+    {
+      if (len == size)
+	{
+	  if (size >= TZIF_FILE_MAX)
+	    goto fail;
+	  size = size ? size * 2 : 1024;
+	  n = realloc (buf, size);
+	  if (!n)
+	    goto fail;
+	  buf = n;
+	}
+      r = read (fd, buf + len, size - len);
+      if (r < 0)
+	goto fail;
+      if (r == 0)
+	break;
+      len += r;
+    }
+  close (fd);
+  *lenp = len;
+  return buf;
+
+fail:
+  close (fd);
+  free (buf);
+  return NULL;
+}
+
+/*
+ * Called by tzset with the TZ value. Loads the linked-in image when
+ * TZ is unset or ":", and the named file for TZ=:path. Returns the
+ * POSIX rule for tzset to parse, or tzenv when TZ does not select
+ * TZif data.
+ */
+const char *
+__tzif_load (const char *tzenv)
+{
+  const char *name = tzenv ? tzenv : ":";
+  size_t len;
+  bool ok;
+
+  if (tzif.valid && tzif_name && strcmp (name, tzif_name) == 0)
+    return tzif_rule;
+
+  tzif.valid = false;
+  free (tzif_file);
+  tzif_file = NULL;
+  free (tzif_name);
+  tzif_name = NULL;
+
+  if (name[0] != ':')
+    return tzenv;
+  if (name[1] == '\0')
+    ok = __tzif_builtin && &__tzif_builtin_size &&
+      tzif_parse (__tzif_builtin, __tzif_builtin_size);
+  else
+    ok = (tzif_file = tzif_read (name + 1, &len)) != NULL &&
+      tzif_parse (tzif_file, len);
+  if (!ok)
+    {
+      free (tzif_file);
+      tzif_file = NULL;
+      return tzenv;
+    }
+  tzif.valid = true;
+  tzif.rule_known = false;
+  tzif_name = strdup (name);
+  return tzif_rule;
+}
+
+/*
+ * Sets *offset (seconds to add to local time to get UTC) for time t and
+ * returns whether DST is in effect, or -1 when the POSIX rule applies.
+ */
+int
+__tzif_localtime (time_t t, long *offset)
+{
+  int32_t k;
+
+  if (!tzif.valid)
+    return -1;
+  k = tzif_find (t);
+  if (tzif_by_rule (k, t))
+    return -1;
+  *offset = -tzif_utoff (k);
+  return tzif_isdst (k);
+}
+
+/*
+ * Picks the transition for local time tim. isdst is the caller's
+ * tm_isdst, which picks the reading of a repeated local time, or the
+ * offset used for a local time that does not exist. Sets *utoffp to
+ * the offset tim was read with.
+ */
+static int32_t
+tzif_local (time_t tim, int isdst, long *utoffp)
+{
+  int32_t k, lo, hi, use = -2, before = -2;
+  long utoff;
+
+  /* Only transitions within a day of tim can matter */
+  lo = tzif_find ((int64_t) tim - TZIF_SLOP);
+  hi = tzif_find ((int64_t) tim + TZIF_SLOP);
+  for (k = lo; k <= hi; k++)
+    {
+      if (tzif_in (k, tim))
+	{
+	  if (use == -2 || isdst < 0 || tzif_isdst (use) != isdst)
+	    use = k;
+	}
+      else if (k + 1 < (int32_t) tzif.timecnt &&
+	       (int64_t) tim - tzif_utoff (k) >= tzif_time (k + 1))
+	before = k;
+    }
+
+  /* Nothing matched: tim was skipped by a transition */
+  if (use == -2)
+    use = before == -2 ? lo : before;
+
+  /* Honor an explicit tm_isdst from a neighboring time type */
+  utoff = tzif_utoff (use);
+  if (isdst >= 0 && tzif_isdst (use) != isdst)
+    {
+      if (use >= 0 && tzif_isdst (use - 1) == isdst)
+	utoff = tzif_utoff (use - 1);
+      else if (use + 1 < (int32_t) tzif.timecnt && tzif_isdst (use + 1) == isdst)
+	utoff = tzif_utoff (use + 1);
+    }
+
+  *utoffp = utoff;
+  return tzif_find ((int64_t) tim - utoff);
+}
+
+/*
+ * Finds the UTC time for local time tim, with isdst as for
+ * tzif_local. Sets *offset for the resulting time and *diff to the
+ * change in the broken-down time, then returns whether DST is in
+ * effect, or -1 when the POSIX rule applies.
+ */
+int
+__tzif_mktime (time_t tim, int isdst, long *offset, long *diff)
+{
+  int32_t k;
+  long utoff;
+
+  if (!tzif.valid)
+    return -1;
+  k = tzif_local (tim, isdst, &utoff);
+  if (tzif_by_rule (k, (int64_t) tim - utoff))
+    return -1;
+  *offset = -tzif_utoff (k);
+  *diff = tzif_utoff (k) - utoff;
+  return tzif_isdst (k);
+}
+
+/*
+ * For strftime: sets *offset and *abbr to the offset and time zone
+ * designation in effect at local time tim, as returned by localtime
+ * or mktime with tm_isdst set to isdst. Returns 0 when the POSIX
+ * rule applies. *abbr stays valid until TZ changes.
+ */
+int
+__tzif_zone (time_t tim, int isdst, long *offset, const char **abbr)
+{
+  int32_t k;
+  long utoff;
+
+  if (!tzif.valid)
+    return 0;
+  k = tzif_local (tim, isdst, &utoff);
+  if (tzif_by_rule (k, (int64_t) tim - utoff))
+    return 0;
+  *offset = -tzif_utoff (k);
+  *abbr = tzif.abbrs + tzif_ttinfo (k)[5];
+  return 1;
+}
+
+#endif /* __TZIF */
@@ -89,13 +89,20 @@ Note that there is no white-space padding between fields. Also note that
 if <[TZ]> is null, the default is Universal Time which has no daylight saving
 time. If <[TZ]> is empty, the default EST5EDT is used.
 
+When picolibc is built with TZif support, a <[TZ]> of the form
+:<[path]> names a TZif time zone file. Its transition table is used for
+times it covers and the POSIX rule in its footer for later times. An
+application may link in a TZif image as <<__tzif_builtin>>, with its size
+in <<__tzif_builtin_size>>, which is used when <[TZ]> is null or ":".
+
 RETURNS
 There is no return value.
 
 PORTABILITY
 <<tzset>> is part of the POSIX standard.
 
-Supporting OS subroutine required: None
+Supporting OS subroutines required: <<open>>, <<read>> and <<close>>
+for <[TZ]>=:<[path]> with TZif support, otherwise None
 */
 
 #define _DEFAULT_SOURCE
@@ -105,6 +112,7 @@ Supporting OS subroutine required: None
 #include <sys/types.h>
 #include <time.h>
 #include <limits.h>
+#include <stdbool.h>
 #include "local.h"
 
 #define TZNAME_MIN	3	/* POSIX min TZ abbr size local def */
@@ -112,6 +120,17 @@ Supporting OS subroutine required: None
 static char __tzname_std[TZNAME_MAX + 2];
 static char __tzname_dst[TZNAME_MAX + 2];
 
+#ifndef __PREFER_SIZE_OVER_SPEED
+/*
+ * The last TZ value parsed. When getenv returns the same pointer with
+ * the same contents, the current settings are still correct.
+ */
+#define TZ_SAVE_MAX	64
+static const char *__tzenv_ptr;
+static char __tzenv_save[TZ_SAVE_MAX];
+static bool __tzenv_saved;
+#endif
+
 void
 _tzset_unlocked (void)
 {
@@ -123,7 +142,31 @@ _tzset_unlocked (void)
   __tzinfo_type *tz = __gettzinfo ();
   static const struct __tzrule_struct default_tzrule = {'J', 0, 0, 0, 0, (time_t)0, 0L };
 
-  if ((tzenv = getenv ("TZ")) == NULL)
+  tzenv = getenv ("TZ");
+
+#ifdef TZ_SAVE_MAX
+  if (__tzenv_saved && tzenv == __tzenv_ptr
+      && (tzenv == NULL || strcmp (tzenv, __tzenv_save) == 0))
+    return;
+
+  __tzenv_ptr = tzenv;
+  __tzenv_saved = tzenv == NULL || strlen (tzenv) < TZ_SAVE_MAX;
+  if (__tzenv_saved && tzenv != NULL)
+    strcpy (__tzenv_save, tzenv);
+#endif
+
+#if __TZ_YEAR_CACHE > 0
+  /* the rules are about to change, so forget any computed years */
+  for (i = 0; i < __TZ_YEAR_CACHE; ++i)
+    tz->__tzcache[i].year = 0;
+#endif
+
+#ifdef __TZIF
+  /* TZif data supplies its own POSIX rule for times after the table */
+  tzenv = (char *) __tzif_load (tzenv);
+#endif
+
+  if (tzenv == NULL)
       {
 	_timezone = 0;
 	_daylight = 0;
@@ -72,7 +72,6 @@ __atod_engine(uint64_t m10, int e10)
     printf("m10 * 10^e10 = %" PRIu64 " * 10^%d\n", m10, e10);
 #endif
 #define signedM 0
-#define RYU_OPTIMIZE_SIZE
 
     // Convert to binary float m2 * 2^e2, while retaining information about whether the conversion
     // was exact (trailingZeros).
@@ -79,6 +79,10 @@ __bufio_flush_locked(FILE *f)
                 }
                 bf->len = 0;
                 bf->off = 0;
+#ifdef __STDIO_MMAP
+                if (bf->bflags & __BMMAP)
+                        __bufio_munmap_locked(f);
+#endif
                 break;
         default:
                 break;
@@ -92,6 +96,12 @@ int __bufio_fill_locked(FILE *f)
 	struct __file_bufio *bf = (struct __file_bufio *) f;
         ssize_t len;
 
+#ifdef __STDIO_MMAP
+        /* The whole file was mapped; look for anything appended since */
+        if (bf->bflags & __BMMAP)
+                __bufio_munmap_locked(f);
+#endif
+
         /* Reset read pointer, read some data */
         bf->off = 0;
         len = bufio_read (bf, bf->buf, bf->size);
@@ -159,6 +169,62 @@ bail:
 	return ret;
 }
 
+#ifdef __STDIO_WRITE_SPAN
+int
+__bufio_write(const char *s, size_t len, FILE *f)
+{
+	struct __file_bufio *bf = (struct __file_bufio *) f;
+        int ret = 0;
+
+	__bufio_lock(f);
+        if (__bufio_setdir_locked(f, __SWR) < 0) {
+                ret = _FDEV_ERR;
+                goto bail;
+        }
+
+        if (len >= (size_t) bf->size) {
+                /* Spans which wouldn't fit in the buffer go direct */
+                if (__bufio_flush_locked(f) < 0) {
+                        ret = _FDEV_ERR;
+                        goto bail;
+                }
+                while (len) {
+                        ssize_t this = bufio_write(bf, s, len);
+                        if (this <= 0) {
+                                ret = _FDEV_ERR;
+                                goto bail;
+                        }
+                        s += this;
+                        len -= this;
+                        bf->pos += this;
+                }
+        } else {
+                /* flush at the end if sending newline when linebuffered */
+                bool newline = (bf->bflags & __BLBF) && memchr(s, '\n', len);
+
+                while (len) {
+                        size_t this = bf->size - bf->len;
+                        if (this > len)
+                                this = len;
+                        memcpy(bf->buf + bf->len, s, this);
+                        bf->len += this;
+                        s += this;
+                        len -= this;
+                        if (bf->len >= bf->size && __bufio_flush_locked(f) < 0) {
+                                ret = _FDEV_ERR;
+                                goto bail;
+                        }
+                }
+                if (newline && __bufio_flush_locked(f) < 0)
+                        ret = _FDEV_ERR;
+        }
+
+bail:
+	__bufio_unlock(f);
+	return ret;
+}
+#endif
+
 extern FILE *const stdin __weak;
 extern FILE *const stdout __weak;
 
@@ -210,6 +276,59 @@ bail:
 	return ret;
 }
 
+#ifdef __STDIO_READ_SPAN
+/*
+ * Return the buffered input, refilling the buffer when empty. On
+ * success, the lock remains held until __bufio_consume is called.
+ */
+int
+__bufio_peek(FILE *f, const char **span)
+{
+	struct __file_bufio *bf = (struct __file_bufio *) f;
+        int ret;
+        bool flushed = false;
+
+again:
+	__bufio_lock(f);
+        if (__bufio_setdir_locked(f, __SRD) < 0) {
+                ret = _FDEV_ERR;
+                goto bail;
+        }
+
+	if (bf->off >= bf->len) {
+                /* Flush stdout if reading from stdin */
+                if (!flushed) {
+                        flushed = true;
+                        if (&stdin != NULL && &stdout != NULL && f == stdin) {
+                                __bufio_unlock(f);
+                                fflush(stdout);
+                                goto again;
+                        }
+		}
+
+                ret = __bufio_fill_locked(f);
+                if (ret)
+                    goto bail;
+	}
+
+        *span = bf->buf + bf->off;
+        return bf->len - bf->off;
+
+bail:
+	__bufio_unlock(f);
+	return ret;
+}
+
+void
+__bufio_consume(FILE *f, size_t len)
+{
+	struct __file_bufio *bf = (struct __file_bufio *) f;
+
+        bf->off += len;
+	__bufio_unlock(f);
+}
+#endif
+
 off_t
 __bufio_seek(FILE *f, off_t offset, int whence)
 {
@@ -223,6 +342,14 @@ __bufio_seek(FILE *f, off_t offset, int whence)
                 /* compute offset of the first char in the buffer */
                 __off_t buf_pos = bf->pos - bf->len;
 
+#ifdef __STDIO_MMAP
+                /* A mapped buffer ends at the end of the file */
+                if (whence == SEEK_END && (bf->bflags & __BMMAP)) {
+                        whence = SEEK_SET;
+                        offset += bf->pos;
+                }
+#endif
+
                 switch (whence) {
                 case SEEK_CUR:
                         /* Map CUR -> SET, accounting for position within buffer */
@@ -244,6 +371,10 @@ __bufio_seek(FILE *f, off_t offset, int whence)
                         /* Flush any buffered data after a real seek */
                         bf->len = 0;
                         bf->off = 0;
+#ifdef __STDIO_MMAP
+                        if (bf->bflags & __BMMAP)
+                                __bufio_munmap_locked(f);
+#endif
                         break;
                 }
         }
@@ -258,6 +389,11 @@ __bufio_setvbuf(FILE *f, char *buf, int mode, size_t size)
         int ret = -1;
 
 	__bufio_lock(f);
+#ifdef __STDIO_MMAP
+        /* Go back to a normal buffer before replacing it */
+        if ((bf->bflags & __BMMAP) && __bufio_flush_locked(f) < 0)
+                goto bail;
+#endif
         bf->bflags &= ~__BLBF;
         switch (mode) {
         case _IONBF:
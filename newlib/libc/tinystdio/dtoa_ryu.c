@@ -110,9 +110,13 @@ d2d(const uint64_t ieeeMantissa, const uint32_t ieeeExponent, int max_digits, bo
 		e10 = (int32_t) q;
 		const int32_t k = DOUBLE_POW5_INV_BITCOUNT + pow5bits((int32_t) q) - 1;
 		const int32_t i = -e2 + (int32_t) q + k;
+#if defined(RYU_OPTIMIZE_SIZE)
 		uint64_t pow5[2];
 		__double_computeInvPow5(q, pow5);
 		vr = mulShiftAll64(m2, pow5, i, &vp, &vm, mmShift);
+#else
+		vr = mulShiftAll64(m2, DOUBLE_POW5_INV_SPLIT[q], i, &vp, &vm, mmShift);
+#endif
 #ifdef RYU_DEBUG
 		printf("%" PRIu64 " * 2^%d / 10^%u\n", mv, e2, q);
 		printf("V+=%" PRIu64 "\nV =%" PRIu64 "\nV-=%" PRIu64 "\n", vp, vr, vm);
@@ -141,9 +145,13 @@ d2d(const uint64_t ieeeMantissa, const uint32_t ieeeExponent, int max_digits, bo
 		const int32_t i = -e2 - (int32_t) q;
 		const int32_t k = pow5bits(i) - DOUBLE_POW5_BITCOUNT;
 		const int32_t j = (int32_t) q - k;
+#if defined(RYU_OPTIMIZE_SIZE)
 		uint64_t pow5[2];
 		__double_computePow5(i, pow5);
 		vr = mulShiftAll64(m2, pow5, j, &vp, &vm, mmShift);
+#else
+		vr = mulShiftAll64(m2, DOUBLE_POW5_SPLIT[i], j, &vp, &vm, mmShift);
+#endif
 
 #ifdef RYU_DEBUG
 		printf("%" PRIu64 " * 5^%d / 10^%u\n", mv, -e2, q);
@@ -43,7 +43,33 @@ fgets(char *str, int size, FILE *stream)
 
 	size--;
 	for (c = 0, cp = str; c != '\n' && size > 0; size--, cp++) {
-		if ((c = getc_unlocked(stream)) == EOF) {
+#ifdef __STDIO_READ_SPAN
+                const char *span;
+                int len = __file_peek(stream, &span);
+
+                if (len > 0) {
+                        /* Copy through the end of the line */
+                        const char *nl;
+
+                        if (len > size)
+                                len = size;
+                        nl = memchr(span, '\n', len);
+                        if (nl) {
+                                len = nl - span + 1;
+                                c = '\n';
+                        }
+                        memcpy(cp, span, len);
+                        __file_consume(stream, len);
+                        cp += len - 1;
+                        size -= len - 1;
+                        continue;
+                }
+                if (len < 0)
+                        c = EOF;
+                else
+#endif
+                c = getc_unlocked(stream);
+		if (c == EOF) {
 			if(cp == str)
 				__funlock_return(stream, NULL);
 			else
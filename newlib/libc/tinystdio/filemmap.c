@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "stdio_private.h"
+
+#ifdef __STDIO_MMAP
+
+#include <sys/stat.h>
+
+#pragma weak mmap
+#pragma weak munmap
+#pragma weak fstat
+
+/*
+ * The mapping becomes the contents of a full buffer which ends at
+ * the end of the file; reads and seeks within the file then need no
+ * system calls. The FD is moved to the end of the file to match.
+ */
+void
+__bufio_mmap(FILE *f)
+{
+        struct __file_bufio *bf = (struct __file_bufio *) f;
+        struct stat st;
+        void *base;
+        int fd = (int) (intptr_t) bf->ptr;
+
+        if (!mmap || !munmap || !fstat)
+                return;
+
+        if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+            st.st_size > INT_MAX)
+                return;
+
+        base = mmap(NULL, (size_t) st.st_size, __STDIO_PROT_READ, __STDIO_MAP_PRIVATE, fd, 0);
+        if (base == __STDIO_MAP_FAILED)
+                return;
+
+        if (bufio_lseek(bf, st.st_size, SEEK_SET) != st.st_size) {
+                (void) munmap(base, (size_t) st.st_size);
+                return;
+        }
+
+        bf->buf = base;
+        bf->size = (int) st.st_size;
+        bf->len = (int) st.st_size;
+        bf->off = 0;
+        bf->pos = st.st_size;
+        bf->dir = __SRD;
+        bf->bflags |= __BMMAP;
+}
+
+void
+__bufio_munmap_locked(FILE *f)
+{
+        struct __file_bufio *bf = (struct __file_bufio *) f;
+
+        (void) munmap(bf->buf, (size_t) bf->size);
+
+        /* fopen allocates BUFSIZ bytes just past the FILE */
+        bf->buf = (char *) (bf + 1);
+        bf->size = BUFSIZ;
+        bf->len = 0;
+        bf->off = 0;
+        bf->bflags &= ~__BMMAP;
+}
+
+#endif
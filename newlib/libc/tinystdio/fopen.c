@@ -50,5 +50,13 @@ fopen(const char *pathname, const char *mode)
 	if (fd < 0)
 		return NULL;
 
+#ifdef __STDIO_MMAP
+        /* Map read-only files, leaving a plain bufio stream if that fails */
+        FILE *f = fdopen(fd, mode);
+        if (f && stdio_flags == __SRD)
+                __bufio_mmap(f);
+        return f;
+#else
 	return fdopen(fd, mode);
+#endif
 }
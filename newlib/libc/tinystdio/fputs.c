@@ -34,14 +34,22 @@
 int
 fputs(const char *str, FILE *stream)
 {
+#ifndef __STDIO_WRITE_SPAN
         int (*put)(char, struct __file *);
 	char c;
+#endif
 	int ret = EOF;
 
 	__flockfile(stream);
 	if ((stream->flags & __SWR) == 0)
 		goto fail;
 
+#ifdef __STDIO_WRITE_SPAN
+        if (__file_write(stream, str, strlen(str)) < 0) {
+                stream->flags |= __SERR;
+                goto fail;
+        }
+#else
         put = stream->put;
 
 	while ((c = *str++) != '\0')
@@ -49,6 +57,7 @@ fputs(const char *str, FILE *stream)
                         stream->flags |= __SERR;
 			goto fail;
                 }
+#endif
 
 	ret = 0;
 fail:
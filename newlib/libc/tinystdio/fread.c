@@ -31,7 +31,7 @@
 
 #include "stdio_private.h"
 
-#ifdef __FAST_BUFIO
+#if defined(__FAST_BUFIO) || defined(__STDIO_READ_SPAN)
 #include "../stdlib/mul_overflow.h"
 #endif
 
@@ -116,6 +116,33 @@ fread(void *ptr, size_t size, size_t nmemb, FILE *stream)
                 __bufio_unlock(stream);
                 __funlock_return(stream, (cp - (uint8_t *) ptr) / size);
         }
+#endif
+#ifdef __STDIO_READ_SPAN
+        size_t remain;
+        if (!mul_overflow(size, nmemb, &remain)) {
+                while (remain) {
+                        const char *span;
+                        int len = __file_peek(stream, &span);
+
+                        if (len < 0)
+                                break;
+                        if (len == 0) {
+                                c = getc_unlocked(stream);
+                                if (c == EOF)
+                                        break;
+                                *cp++ = (uint8_t)c;
+                                remain--;
+                                continue;
+                        }
+                        if ((size_t) len > remain)
+                                len = remain;
+                        memcpy(cp, span, len);
+                        __file_consume(stream, len);
+                        cp += len;
+                        remain -= len;
+                }
+                __funlock_return(stream, (cp - (uint8_t *) ptr) / size);
+        }
 #endif
 	for (i = 0; i < nmemb; i++)
 		for (j = 0; j < size; j++) {
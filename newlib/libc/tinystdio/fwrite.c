@@ -38,7 +38,7 @@
 size_t
 fwrite(const void *ptr, size_t size, size_t nmemb, FILE *stream)
 {
-	size_t i, j;
+	size_t i;
 	const uint8_t *cp = (const uint8_t *) ptr;
 
         __flockfile(stream);
@@ -94,10 +94,18 @@ fwrite(const void *ptr, size_t size, size_t nmemb, FILE *stream)
                 __funlock_return(stream, (cp - (uint8_t *) ptr) / size);
         }
 #endif
+#ifdef __STDIO_WRITE_SPAN
+	for (i = 0; i < nmemb; i++) {
+                if (__file_write(stream, (const char *) cp, size) < 0)
+                        __funlock_return(stream, i);
+                cp += size;
+        }
+#else
 	for (i = 0; i < nmemb; i++)
-		for (j = 0; j < size; j++)
+		for (size_t j = 0; j < size; j++)
 			if (stream->put(*cp++, stream) < 0)
 				__funlock_return(stream, i);
+#endif
 
 	__funlock_return(stream, i);
 }
@@ -47,11 +47,52 @@ getdelim (char **restrict lineptr, size_t *restrict nptr,
 
     __flockfile(stream);
     for (;;) {
+#ifdef __STDIO_READ_SPAN
+        const char *span;
+        int len = __file_peek(stream, &span);
+
+        if (len < 0)
+            break;
+        if (len > 0) {
+            /* Copy through the delimiter, leaving room for the NUL */
+            const char *end = memchr(span, delim, len);
+            size_t this = end ? (size_t) (end - span) + 1 : (size_t) len;
+
+            if ((size_t) count + this >= n) {
+                size_t newsize = n + INCR;
+                char *newline;
+                if (newsize <= (size_t) count + this)
+                    newsize = (size_t) count + this + 1;
+
+                /*
+                 * Release the span (and the stream lock held with
+                 * it) before calling realloc, then peek again
+                 */
+                __file_consume(stream, 0);
+                newline = realloc(line, newsize);
+                if (newline == NULL) {
+                    count = -1;
+                    break;
+                }
+                line = newline;
+                n = newsize;
+                continue;
+            }
+
+            memcpy(line + count, span, this);
+            __file_consume(stream, this);
+            count += this;
+            if (end)
+                break;
+            continue;
+        }
+#endif
         int c = getc_unlocked(stream);
         if (c == EOF)
             break;
 
-        if (count >= (_ssize_t) n) {
+        /* Leave room for the NUL */
+        if ((size_t) count + 1 >= n) {
             size_t newsize = n + INCR;
             char *newline = realloc(line, newsize);
             if (newline == NULL) {
@@ -63,12 +104,16 @@ getdelim (char **restrict lineptr, size_t *restrict nptr,
         }
 
         line[count++] = c;
-        if (c == delim) {
-            line[count] = '\0';
+        if (c == delim)
             break;
-        }
     }
 
+    /* Return -1 at end of file with nothing read */
+    if (count == 0)
+        count = -1;
+    else if (count > 0)
+        line[count] = '\0';
+
     *lineptr = line;
     *nptr = n;
     __funlock_return(stream, count);
@@ -34,8 +34,10 @@
 int
 puts(const char *str)
 {
+#ifndef __STDIO_WRITE_SPAN
         int (*put)(char, struct __file *);
 	char c;
+#endif
 	int ret = EOF;
         FILE *out = stdout;
 
@@ -44,6 +46,11 @@ puts(const char *str)
 	if ((out->flags & __SWR) == 0)
 		goto exit;
 
+#ifdef __STDIO_WRITE_SPAN
+        if (__file_write(out, str, strlen(str)) < 0 ||
+            __file_write(out, "\n", 1) < 0)
+                goto flag_exit;
+#else
         put = out->put;
 	while ((c = *str++) != '\0')
 		if (put(c, out) < 0)
@@ -51,6 +58,7 @@ puts(const char *str)
 
 	if (put('\n', out) < 0)
 		goto flag_exit;
+#endif
 
 	ret = 0;
 	goto exit;
@@ -24,6 +24,12 @@
 #define assert(x)
 //#include <assert.h>
 
+// Compute the powers of five from small tables unless the full tables
+// have been requested.
+#ifndef __IO_FLOAT_RYU_TABLES
+#define RYU_OPTIMIZE_SIZE
+#endif
+
 #if __SIZEOF_POINTER__ == 4
 #define RYU_32_BIT_PLATFORM
 #endif
@@ -41,6 +47,8 @@
 static inline int max_int(int a, int b) { return a > b ? a : b; }
 static inline int min_int(int a, int b) { return a < b ? a : b; }
 
+#if defined(RYU_OPTIMIZE_SIZE)
+
 // Returns e == 0 ? 1 : [log_2(5^e)]; requires 0 <= e <= 3528.
 int32_t __log2pow5(const int32_t e);
 
@@ -66,6 +74,33 @@ uint32_t __log10Pow5(const int32_t e);
 
 #define log10Pow5(e) __log10Pow5(e)
 
+#else // defined(RYU_OPTIMIZE_SIZE)
+
+// When speed matters, inline these instead of calling the versions
+// in ryu_log10.c, ryu_log2pow5.c and ryu_pow5bits.c.
+
+static inline int32_t log2pow5(const int32_t e) {
+  return (int32_t) ((((uint32_t) e) * 1217359) >> 19);
+}
+
+static inline int32_t ceil_log2pow5(const int32_t e) {
+  return log2pow5(e) + 1;
+}
+
+static inline int32_t pow5bits(const int32_t e) {
+  return (int32_t) (((((uint32_t) e) * 1217359) >> 19) + 1);
+}
+
+static inline uint32_t log10Pow2(const int32_t e) {
+  return (((uint32_t) e) * 78913) >> 18;
+}
+
+static inline uint32_t log10Pow5(const int32_t e) {
+  return (((uint32_t) e) * 732923) >> 20;
+}
+
+#endif // defined(RYU_OPTIMIZE_SIZE)
+
 static inline uint32_t float_to_bits(const float f) {
   uint32_t bits = 0;
   memcpy(&bits, &f, sizeof(float));
@@ -86,8 +121,24 @@ static inline uint64_t ryu64_to_bits(const RYU64 d) {
 #define DOUBLE_POW5_INV_BITCOUNT 125
 #define DOUBLE_POW5_BITCOUNT 125
 
+#if defined(RYU_OPTIMIZE_SIZE)
+
 void __double_computePow5(const uint32_t i, uint64_t* const result);
 
 void __double_computeInvPow5(const uint32_t i, uint64_t* const result);
 
+#else // defined(RYU_OPTIMIZE_SIZE)
+
+// Large enough for all exponents passed to __atod_engine by scanf
+#define DOUBLE_POW5_INV_TABLE_SIZE 343
+#define DOUBLE_POW5_TABLE_SIZE 326
+
+extern const uint64_t __double_pow5_inv_split[DOUBLE_POW5_INV_TABLE_SIZE][2];
+extern const uint64_t __double_pow5_split[DOUBLE_POW5_TABLE_SIZE][2];
+
+#define DOUBLE_POW5_INV_SPLIT __double_pow5_inv_split
+#define DOUBLE_POW5_SPLIT __double_pow5_split
+
+#endif // defined(RYU_OPTIMIZE_SIZE)
+
 #endif // RYU_COMMON_H
@@ -57,7 +57,7 @@ static inline uint64_t shiftright128(const uint64_t lo, const uint64_t hi, const
   return __shiftright128(lo, hi, (unsigned char) dist);
 }
 
-#else // defined(HAS_64_BIT_INTRINSICS)
+#elif defined(RYU_OPTIMIZE_SIZE)
 
 uint64_t __umul128(const uint64_t a, const uint64_t b, uint64_t* const productHi);
 #define umul128(a,b,hi) __umul128(a,b,hi)
@@ -65,6 +65,59 @@ uint64_t __umul128(const uint64_t a, const uint64_t b, uint64_t* const productHi
 uint64_t __shiftright128(const uint64_t lo, const uint64_t hi, const uint32_t dist);
 #define shiftright128(lo,hi,dist) __shiftright128(lo,hi,dist)
 
+#elif defined(HAS_UINT128)
+
+static inline uint64_t umul128(const uint64_t a, const uint64_t b, uint64_t* const productHi) {
+  const uint128_t p = (uint128_t) a * b;
+  *productHi = (uint64_t) (p >> 64);
+  return (uint64_t) p;
+}
+
+static inline uint64_t shiftright128(const uint64_t lo, const uint64_t hi, const uint32_t dist) {
+  assert(dist < 64);
+  assert(dist > 0);
+  return (hi << (64 - dist)) | (lo >> dist);
+}
+
+#else // defined(HAS_UINT128)
+
+static inline uint64_t umul128(const uint64_t a, const uint64_t b, uint64_t* const productHi) {
+  // The casts here help MSVC to avoid calls to the __allmul library function.
+  const uint32_t aLo = (uint32_t)a;
+  const uint32_t aHi = (uint32_t)(a >> 32);
+  const uint32_t bLo = (uint32_t)b;
+  const uint32_t bHi = (uint32_t)(b >> 32);
+
+  const uint64_t b00 = (uint64_t)aLo * bLo;
+  const uint64_t b01 = (uint64_t)aLo * bHi;
+  const uint64_t b10 = (uint64_t)aHi * bLo;
+  const uint64_t b11 = (uint64_t)aHi * bHi;
+
+  const uint32_t b00Lo = (uint32_t)b00;
+  const uint32_t b00Hi = (uint32_t)(b00 >> 32);
+
+  const uint64_t mid1 = b10 + b00Hi;
+  const uint32_t mid1Lo = (uint32_t)(mid1);
+  const uint32_t mid1Hi = (uint32_t)(mid1 >> 32);
+
+  const uint64_t mid2 = b01 + mid1Lo;
+  const uint32_t mid2Lo = (uint32_t)(mid2);
+  const uint32_t mid2Hi = (uint32_t)(mid2 >> 32);
+
+  const uint64_t pHi = b11 + mid1Hi + mid2Hi;
+  const uint64_t pLo = ((uint64_t)mid2Lo << 32) | b00Lo;
+
+  *productHi = pHi;
+  return pLo;
+}
+
+static inline uint64_t shiftright128(const uint64_t lo, const uint64_t hi, const uint32_t dist) {
+  // We don't need to handle the case dist >= 64 here (see above).
+  assert(dist < 64);
+  assert(dist > 0);
+  return (hi << (64 - dist)) | (lo >> dist);
+}
+
 #endif // defined(HAS_64_BIT_INTRINSICS)
 
 #if defined(RYU_32_BIT_PLATFORM)
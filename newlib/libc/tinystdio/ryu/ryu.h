@@ -17,8 +17,6 @@
 #ifndef RYU_H
 #define RYU_H
 
-#define RYU_OPTIMIZE_SIZE
-
 #include <inttypes.h>
 
 int d2s_buffered_n(double f, char* result);
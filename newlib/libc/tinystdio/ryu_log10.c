@@ -16,6 +16,9 @@
 // KIND, either express or implied.
 #include "ryu/common.h"
 
+// Inline versions in ryu/common.h are used with the full tables
+#if defined(RYU_OPTIMIZE_SIZE)
+
 // Returns floor(log_10(2^e)); requires 0 <= e <= 1650.
 uint32_t __log10Pow2(const int32_t e) {
   // The first value this approximation fails for is 2^1651 which is just greater than 10^297.
@@ -32,3 +35,4 @@ uint32_t __log10Pow5(const int32_t e) {
   return (((uint32_t) e) * 732923) >> 20;
 }
 
+#endif // defined(RYU_OPTIMIZE_SIZE)
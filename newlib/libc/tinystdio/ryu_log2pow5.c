@@ -17,6 +17,9 @@
 
 #include "ryu/common.h"
 
+// Inline versions in ryu/common.h are used with the full tables
+#if defined(RYU_OPTIMIZE_SIZE)
+
 // Returns e == 0 ? 1 : [log_2(5^e)]; requires 0 <= e <= 3528.
 int32_t __log2pow5(const int32_t e) {
   // This approximation works up to the point that the multiplication overflows at e = 3529.
@@ -32,3 +35,4 @@ int32_t __ceil_log2pow5(const int32_t e) {
   return log2pow5(e) + 1;
 }
 
+#endif // defined(RYU_OPTIMIZE_SIZE)
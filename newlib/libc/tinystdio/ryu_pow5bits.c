@@ -17,6 +17,9 @@
 
 #include "ryu/common.h"
 
+// Inline versions in ryu/common.h are used with the full tables
+#if defined(RYU_OPTIMIZE_SIZE)
+
 int32_t __pow5bits(const int32_t e) {
   // This approximation works up to the point that the multiplication overflows at e = 3529.
   // If the multiplication were done in 64 bits, it would fail at 5^4004 which is just greater
@@ -26,3 +29,4 @@ int32_t __pow5bits(const int32_t e) {
   return (int32_t) (((((uint32_t) e) * 1217359) >> 19) + 1);
 }
 
+#endif // defined(RYU_OPTIMIZE_SIZE)
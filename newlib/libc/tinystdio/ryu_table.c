@@ -20,6 +20,8 @@
 #include "ryu/common.h"
 #include "ryu/d2s_intrinsics.h"
 
+#if defined(RYU_OPTIMIZE_SIZE)
+
 static const uint64_t DOUBLE_POW5_INV_SPLIT2[15][2] = {
   {                    1u, 2305843009213693952u },
   {  5955668970331000884u, 1784059615882449851u },
@@ -76,6 +78,12 @@ static const uint64_t DOUBLE_POW5_TABLE[POW5_TABLE_SIZE] = {
 298023223876953125ull //, 1490116119384765625ull
 };
 
+#else // defined(RYU_OPTIMIZE_SIZE)
+
+#include "ryu/d2s_full_table.h"
+
+#endif // defined(RYU_OPTIMIZE_SIZE)
+
 uint32_t __pow5Factor(uint64_t value) {
   const uint64_t m_inv_5 = 14757395258967641293u; // 5 * m_inv_5 = 1 (mod 2^64)
   const uint64_t n_div_5 = 3689348814741910323u;  // #{ n | n = 0 (mod 2^64) } = 2^64 / 5
@@ -90,7 +98,11 @@ uint32_t __pow5Factor(uint64_t value) {
   return count;
 }
 
-#if defined(HAS_UINT128)
+#if !defined(RYU_OPTIMIZE_SIZE)
+
+// The full tables are used directly
+
+#elif defined(HAS_UINT128)
 
 // Computes 5^i in the form required by Ryu, and stores it in the given pointer.
 void __double_computePow5(const uint32_t i, uint64_t* const result) {
@@ -19,7 +19,7 @@
 #include "ryu/common.h"
 #include "ryu/d2s_intrinsics.h"
 
-#if !defined(HAS_64_BIT_INTRINSICS)
+#if !defined(HAS_64_BIT_INTRINSICS) && defined(RYU_OPTIMIZE_SIZE)
 
 uint64_t __umul128(const uint64_t a, const uint64_t b, uint64_t* const productHi) {
   // The casts here help MSVC to avoid calls to the __allmul library function.
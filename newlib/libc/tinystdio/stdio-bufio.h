@@ -44,6 +44,7 @@
 #define __BLBF  0x0002          /* bufio is line buffered */
 #define __BFALL 0x0004          /* FILE is allocated by stdio */
 #define __BFPTR 0x0008          /* funcs need pointers instead of ints */
+#define __BMMAP 0x0010          /* bufio buf is an mmap of the file */
 
 union __file_bufio_cookie {
         int	fd;
@@ -85,9 +86,24 @@ struct __file_bufio {
 #endif
 };
 
+#ifdef __STDIO_WRITE_SPAN
+#define __BUFIO_WRITE   __bufio_write
+#else
+#define __BUFIO_WRITE   NULL
+#endif
+
+#ifdef __STDIO_READ_SPAN
+#define __BUFIO_PEEK    __bufio_peek
+#define __BUFIO_CONSUME __bufio_consume
+#else
+#define __BUFIO_PEEK    NULL
+#define __BUFIO_CONSUME NULL
+#endif
+
 #define FDEV_SETUP_BUFIO(_fd, _buf, _size, _read, _write, _lseek, _close, _rwflag, _bflags) \
         {                                                               \
-                .xfile = FDEV_SETUP_EXT(__bufio_put, __bufio_get,     \
+                .xfile = __FDEV_SETUP_EXT(__bufio_put, __BUFIO_WRITE, __bufio_get, \
+                                        __BUFIO_PEEK, __BUFIO_CONSUME,  \
                                         __bufio_flush, __bufio_close,   \
                                         __bufio_seek, __bufio_setvbuf,  \
                                         (_rwflag) | __SBUF),            \
@@ -107,7 +123,8 @@ struct __file_bufio {
 
 #define FDEV_SETUP_BUFIO_PTR(_ptr, _buf, _size, _read, _write, _lseek, _close, _rwflag, _bflags) \
         {                                                               \
-                .xfile = FDEV_SETUP_EXT(__bufio_put, __bufio_get,     \
+                .xfile = __FDEV_SETUP_EXT(__bufio_put, __BUFIO_WRITE, __bufio_get, \
+                                        __BUFIO_PEEK, __BUFIO_CONSUME,  \
                                         __bufio_flush, __bufio_close,   \
                                         __bufio_seek, __bufio_setvbuf,  \
                                         (_rwflag) | __SBUF),            \
@@ -145,7 +162,7 @@ static inline void __bufio_lock(FILE *f) {
 #ifdef __STDIO_BUFIO_LOCKING
         struct __file_bufio *bf = (struct __file_bufio *) f;
         if (!bf->lock)
-            __lock_init(bf->lock);
+            __bufio_lock_init(f);
 	__lock_acquire(bf->lock);
 #endif
 	(void) f;
@@ -174,9 +191,22 @@ __bufio_flush(FILE *f);
 int
 __bufio_put(char c, FILE *f);
 
+#ifdef __STDIO_WRITE_SPAN
+int
+__bufio_write(const char *s, size_t len, FILE *f);
+#endif
+
 int
 __bufio_get(FILE *f);
 
+#ifdef __STDIO_READ_SPAN
+int
+__bufio_peek(FILE *f, const char **span);
+
+void
+__bufio_consume(FILE *f, size_t len);
+#endif
+
 off_t
 __bufio_seek(FILE *f, off_t offset, int whence);
 
@@ -100,6 +100,13 @@ struct __file {
 	int	(*put)(char, struct __file *);	/* function to write one char to device */
 	int	(*get)(struct __file *);	/* function to read one char from device */
 	int	(*flush)(struct __file *);	/* function to flush output to device */
+#ifdef __STDIO_WRITE_SPAN
+	int	(*write)(const char *, size_t, struct __file *); /* function to write a span of chars to device */
+#endif
+#ifdef __STDIO_READ_SPAN
+	int	(*peek)(struct __file *, const char **);	/* function to fetch buffered input span */
+	void	(*consume)(struct __file *, size_t);	/* function to discard peeked input */
+#endif
 #ifdef __STDIO_LOCKING
 	_LOCK_RECURSIVE_T lock;
 #endif
@@ -120,25 +127,31 @@ struct __file_close {
 	int	(*close)(struct __file *);	/* function to close file */
 };
 
-#define FDEV_SETUP_CLOSE(__put, __get, __flush, __close, __flags) \
+#define __FDEV_SETUP_CLOSE(__put, __write, __get, __peek, __consume, __flush, __close, __flags) \
         {                                                               \
-                .file = FDEV_SETUP_STREAM(__put, __get, __flush, (__flags) | __SCLOSE),   \
+                .file = __FDEV_SETUP_STREAM(__put, __write, __get, __peek, __consume, __flush, (__flags) | __SCLOSE), \
                 .close = (__close),                                      \
         }
 
+#define FDEV_SETUP_CLOSE(__put, __get, __flush, __close, __flags) \
+        __FDEV_SETUP_CLOSE(__put, NULL, __get, NULL, NULL, __flush, __close, __flags)
+
 struct __file_ext {
         struct __file_close cfile;              /* close file struct */
         __off_t (*seek)(struct __file *, __off_t offset, int whence);
         int     (*setvbuf)(struct __file *, char *buf, int mode, size_t size);
 };
 
-#define FDEV_SETUP_EXT(__put, __get, __flush, __close, __seek, __setvbuf, __flags) \
+#define __FDEV_SETUP_EXT(__put, __write, __get, __peek, __consume, __flush, __close, __seek, __setvbuf, __flags) \
         {                                                               \
-                .cfile = FDEV_SETUP_CLOSE(__put, __get, __flush, __close, (__flags) | __SEXT), \
+                .cfile = __FDEV_SETUP_CLOSE(__put, __write, __get, __peek, __consume, __flush, __close, (__flags) | __SEXT), \
                 .seek = (__seek),                                        \
                 .setvbuf = (__setvbuf),                                  \
         }
 
+#define FDEV_SETUP_EXT(__put, __get, __flush, __close, __seek, __setvbuf, __flags) \
+        __FDEV_SETUP_EXT(__put, NULL, __get, NULL, NULL, __flush, __close, __seek, __setvbuf, __flags)
+
 /*@{*/
 /**
    \c FILE is the opaque structure that is passed around between the
@@ -195,14 +208,31 @@ extern FILE *const stderr;
  */
 #define _FDEV_EOF (-2)
 
-#define FDEV_SETUP_STREAM(__put, __get, __flush, __flags)        \
+#ifdef __STDIO_WRITE_SPAN
+#define __FDEV_WRITE_INIT(__write) .write = (__write),
+#else
+#define __FDEV_WRITE_INIT(__write)
+#endif
+
+#ifdef __STDIO_READ_SPAN
+#define __FDEV_READ_INIT(__peek, __consume) .peek = (__peek), .consume = (__consume),
+#else
+#define __FDEV_READ_INIT(__peek, __consume)
+#endif
+
+#define __FDEV_SETUP_STREAM(__put, __write, __get, __peek, __consume, __flush, __flags) \
 	{                                           \
                 .flags = (__flags),                 \
                 .put = (__put),                     \
                 .get = (__get),                     \
                 .flush = (__flush),                 \
+                __FDEV_WRITE_INIT(__write)          \
+                __FDEV_READ_INIT(__peek, __consume) \
 	}
 
+#define FDEV_SETUP_STREAM(__put, __get, __flush, __flags)        \
+        __FDEV_SETUP_STREAM(__put, NULL, __get, NULL, NULL, __flush, __flags)
+
 FILE *fdevopen(int (*__put)(char, FILE*), int (*__get)(FILE*), int(*__flush)(FILE *));
 int	fclose(FILE *__stream);
 int	fflush(FILE *stream);
@@ -66,9 +66,94 @@ __file_wstr_get(FILE *stream);
 int
 __file_str_put(char c, FILE *stream);
 
+#ifdef __STDIO_READ_SPAN
+/* Limit string spans to avoid scanning the whole string on each peek */
+#define __FILE_STR_SPAN 64
+
+int
+__file_str_peek(FILE *stream, const char **span);
+
+void
+__file_str_consume(FILE *stream, size_t len);
+
+#define __FILE_STR_PEEK         __file_str_peek
+#define __FILE_STR_CONSUME      __file_str_consume
+#else
+#define __FILE_STR_PEEK         NULL
+#define __FILE_STR_CONSUME      NULL
+#endif
+
 int
 __file_str_put_alloc(char c, FILE *stream);
 
+#ifdef __STDIO_WRITE_SPAN
+int
+__file_str_write(const char *s, size_t len, FILE *stream);
+
+int
+__file_str_write_alloc(const char *s, size_t len, FILE *stream);
+
+#define __FILE_STR_WRITE        __file_str_write
+#define __FILE_STR_WRITE_ALLOC  __file_str_write_alloc
+#else
+#define __FILE_STR_WRITE        NULL
+#define __FILE_STR_WRITE_ALLOC  NULL
+#endif
+
+/*
+ * Write a span of characters, using the stream write function when
+ * present and falling back to one put call per character otherwise
+ */
+static inline int
+__file_write(FILE *stream, const char *s, size_t len)
+{
+#ifdef __STDIO_WRITE_SPAN
+        if (stream->write)
+                return stream->write(s, len, stream);
+#endif
+        while (len--)
+                if (stream->put(*s++, stream) < 0)
+                        return _FDEV_ERR;
+        return 0;
+}
+
+#ifdef __STDIO_MMAP
+/*
+ * Read-only regular files opened with fopen are mapped into memory
+ * and the mapping used as the bufio buffer, with the __BMMAP flag
+ * set. Anything which would refill or discard the buffer unmaps the
+ * file and switches back to the buffer allocated with the FILE.
+ *
+ * picolibc has no <sys/mman.h>, so mmap and munmap are declared
+ * here using the common POSIX values for PROT_READ, MAP_PRIVATE and
+ * MAP_FAILED. Targets with different values can define the
+ * __STDIO_PROT_READ, __STDIO_MAP_PRIVATE and __STDIO_MAP_FAILED
+ * macros in their compiler flags. The functions are weak so that
+ * targets without them fall back to plain bufio streams.
+ */
+void *mmap(void *addr, size_t len, int prot, int flags, int fd, off_t off);
+int munmap(void *addr, size_t len);
+
+#ifndef __STDIO_PROT_READ
+#define __STDIO_PROT_READ       0x1
+#endif
+#ifndef __STDIO_MAP_PRIVATE
+#define __STDIO_MAP_PRIVATE     0x2
+#endif
+#ifndef __STDIO_MAP_FAILED
+#define __STDIO_MAP_FAILED      ((void *) -1)
+#endif
+
+/* Map the file behind a newly opened read-only bufio FILE */
+void
+__bufio_mmap(FILE *f);
+
+/* Unmap the file, switching back to the FILE's own buffer. Called
+ * with the buffer empty and the bufio lock held */
+void
+__bufio_munmap_locked(FILE *f);
+#endif
+
 extern const char __match_inf[];
 extern const char __match_inity[];
 extern const char __match_nan[];
@@ -90,6 +175,7 @@ bool __matchcaseprefix(const char *input, const char *pattern);
 		.file = {			\
 			.flags = __SRD,		\
                         .get = __file_str_get,  \
+                        __FDEV_READ_INIT(__FILE_STR_PEEK, __FILE_STR_CONSUME) \
                         __LOCK_INIT_NONE        \
 		},				\
 		.pos = (char *) (_s)		\
@@ -112,6 +198,7 @@ bool __matchcaseprefix(const char *input, const char *pattern);
 		.file = {			\
 			.flags = __SWR,		\
 			.put = __file_str_put,	\
+                        __FDEV_WRITE_INIT(__FILE_STR_WRITE) \
                         __LOCK_INIT_NONE        \
 		},				\
 		.pos = (_s),			\
@@ -122,6 +209,7 @@ bool __matchcaseprefix(const char *input, const char *pattern);
 		.file = {			\
 			.flags = __SWR,		\
 			.put = __file_str_put_alloc,	\
+                        __FDEV_WRITE_INIT(__FILE_STR_WRITE_ALLOC) \
                         __LOCK_INIT_NONE        \
 		},				\
 		.pos = NULL,			\
@@ -134,6 +222,7 @@ bool __matchcaseprefix(const char *input, const char *pattern);
 		.file = {			\
 			.flags = __SWR,		\
 			.put = __file_str_put_alloc,	\
+                        __FDEV_WRITE_INIT(__FILE_STR_WRITE_ALLOC) \
                         __LOCK_INIT_NONE        \
 		},				\
 		.pos = _buf,			\
@@ -787,6 +876,37 @@ __picolibc_non_atomic_compare_exchange_ungetc(__ungetc_t *p,
 
 #endif /* __ATOMIC_UNGETC */
 
+#ifdef __STDIO_READ_SPAN
+/*
+ * Fetch the next span of buffered input. Returns the length of the
+ * span, 0 when the caller must use getc instead (the stream has no
+ * peek function or holds an ungetc character) or EOF after setting
+ * the error or end-of-file flag. A positive return must be followed
+ * by __file_consume.
+ */
+static inline int
+__file_peek(FILE *stream, const char **span)
+{
+        int len;
+
+        if (!stream->peek || __atomic_load_ungetc(&stream->unget))
+                return 0;
+        len = stream->peek(stream, span);
+        if (len < 0) {
+		/* if != _FDEV_ERR, assume it's _FDEV_EOF */
+                stream->flags |= (len == _FDEV_ERR) ? __SERR : __SEOF;
+                return EOF;
+        }
+        return len;
+}
+
+static inline void
+__file_consume(FILE *stream, size_t len)
+{
+        stream->consume(stream, len);
+}
+#endif
+
 /*
  * This operates like _tolower on upper case letters, but also works
  * correctly on lower case letters.
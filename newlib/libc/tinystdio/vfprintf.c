@@ -449,6 +449,15 @@ skip_to_arg(const CHAR *fmt_orig, my_va_list *ap, int target_argno)
 }
 #endif
 
+/*
+ * When the stream accepts spans of characters, hand it literal text,
+ * strings, padding and integer digits in one call instead of one
+ * put call per character
+ */
+#if defined(__STDIO_WRITE_SPAN) && !defined(WIDE_CHARS) && !defined(_NEED_IO_SHRINK)
+#define PRINTF_WRITE_SPAN
+#endif
+
 #ifdef _NEED_IO_WIDETOMB
 /*
  * Compute the number of bytes to encode a wide string
@@ -497,6 +506,26 @@ _wcslen(const char *s, size_t maxlen)
 }
 #endif
 
+#ifdef PRINTF_WRITE_SPAN
+/*
+ * Write 'n' copies of 'c'
+ */
+static int
+write_pad(FILE *stream, char c, int n)
+{
+    char pad[16];
+
+    memset(pad, c, sizeof(pad));
+    while (n > 0) {
+        int this = n < (int) sizeof(pad) ? n : (int) sizeof(pad);
+        if (__file_write(stream, pad, this) < 0)
+            return _FDEV_ERR;
+        n -= this;
+    }
+    return 0;
+}
+#endif
+
 #ifdef VFPRINTF_S
 int
 vfprintf_s(FILE *__restrict stream, const char *__restrict fmt, va_list ap_orig)
@@ -558,6 +587,11 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
     int (*put)(char, FILE *) = stream->put;
 #define my_putc(c, stream) do { ++stream_len; if (put(c, stream) < 0) goto fail; } while(0)
 #endif
+#endif
+
+#ifdef PRINTF_WRITE_SPAN
+#define my_write(s, n, stream) do { stream_len += (int) (n); if (__file_write(stream, s, n) < 0) goto fail; } while(0)
+#define my_pad(c, n, stream) do { stream_len += (n); if (write_pad(stream, c, n) < 0) goto fail; } while(0)
 #endif
 
     __flockfile(stream);
@@ -571,6 +605,20 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 
     for (;;) {
 
+#ifdef PRINTF_WRITE_SPAN
+	for (;;) {
+	    const char *lit = fmt;
+	    while ((c = *fmt) && c != '%')
+		fmt++;
+	    if (fmt != lit)
+		my_write (lit, (size_t) (fmt - lit), stream);
+	    if (!c) goto ret;
+	    fmt++;
+	    c = *fmt++;
+	    if (c != '%') break;
+	    my_putc (c, stream);
+	}
+#else
 	for (;;) {
 	    c = *fmt++;
 	    if (!c) goto ret;
@@ -580,6 +628,7 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 	    }
 	    my_putc (c, stream);
 	}
+#endif
 
 	flags = 0;
 	width = 0;
@@ -1144,10 +1193,17 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 #endif
             str_lpad:
                 if (!(flags & FL_LPAD)) {
+#ifdef PRINTF_WRITE_SPAN
+                    if ((size_t) width > size) {
+                        my_pad (' ', width - (int) size, stream);
+                        width = (int) size;
+                    }
+#else
                     while ((size_t) width > size) {
                         my_putc (' ', stream);
                         width--;
                     }
+#endif
                 }
                 width -= size;
 #ifdef _NEED_IO_WCHAR
@@ -1179,6 +1235,9 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
                         my_putc(c, stream);
                         pnt += mb_len;
                     }
+#elif defined(PRINTF_WRITE_SPAN)
+                    if (size)
+                        my_write (pnt, size, stream);
 #else
                     while (size--)
                         my_putc (*pnt++, stream);
@@ -1313,10 +1372,17 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
                             len = width;
                         }
                     }
+#ifdef PRINTF_WRITE_SPAN
+                    if (len < width) {
+                        my_pad (' ', width - len, stream);
+                        len = width;
+                    }
+#else
                     while (len < width) {
                         my_putc (' ', stream);
                         len++;
                     }
+#endif
                 }
 
                 /* Width remaining on right after value */
@@ -1335,10 +1401,17 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
                 }
 
                 /* Output leading zeros */
+#ifdef PRINTF_WRITE_SPAN
+                if (prec > buf_len) {
+                    my_pad ('0', prec - buf_len, stream);
+                    prec = buf_len;
+                }
+#else
                 while (prec > buf_len) {
                     my_putc ('0', stream);
                     prec--;
                 }
+#endif
 #else
                 if (flags & FL_ALT) {
                     my_putc ('0', stream);
@@ -1349,16 +1422,32 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 #endif
 
                 /* Output value */
+#ifdef PRINTF_WRITE_SPAN
+                /* Digits are generated in reverse order */
+                for (int i = 0, j = buf_len - 1; i < j; i++, j--) {
+                    char t = buf[i];
+                    buf[i] = buf[j];
+                    buf[j] = t;
+                }
+                if (buf_len)
+                    my_write (buf, (size_t) buf_len, stream);
+#else
                 while (buf_len)
                     my_putc (buf[--buf_len], stream);
+#endif
             }
         }
 
 #ifndef _NEED_IO_SHRINK
 	/* Tail is possible.	*/
+#ifdef PRINTF_WRITE_SPAN
+	if (width > 0)
+	    my_pad (' ', width, stream);
+#else
 	while (width-- > 0) {
 	    my_putc (' ', stream);
 	}
+#endif
 #endif
     } /* for (;;) */
 
@@ -1368,6 +1457,8 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 #endif
     __funlock_return(stream, stream_len);
 #undef my_putc
+#undef my_write
+#undef my_pad
 #undef ap
   fail:
     stream->flags |= __SERR;
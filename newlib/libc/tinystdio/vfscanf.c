@@ -113,6 +113,14 @@ typedef long int_scanf_t;
 # endif
 #endif
 
+/*
+ * When the stream can expose its buffered input, convert runs of
+ * digits directly from that instead of one getc call per digit
+ */
+#if defined(__STDIO_READ_SPAN) && !defined(WIDE_CHARS)
+#define SCANF_READ_SPAN
+#endif
+
 #ifdef WIDE_CHARS
 typedef struct {
     int         len;
@@ -318,6 +326,24 @@ conv_int (FILE *stream, scanf_context_t *context, width_t width, void *addr, uin
         flags |= FL_ANY;
         val = val * base + c;
 	if (!--width) goto putval;
+#ifdef SCANF_READ_SPAN
+        const char *span;
+        int len = __file_peek(stream, &span);
+        if (len < 0)
+            break;
+        if (len > 0) {
+            int n = 0;
+            while (n < len && (c = digit_to_val((unsigned char) span[n])) < base) {
+                val = val * base + c;
+                n++;
+                if (!--width)
+                    break;
+            }
+            __file_consume(stream, n);
+            scanf_len(context) += n;
+            if (!width) goto putval;
+        }
+#endif
     } while (!IS_EOF(i = scanf_getc(stream, context)));
     if (!(flags & FL_ANY))
         goto err;
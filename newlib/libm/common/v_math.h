@@ -0,0 +1,602 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Lane-parallel versions of the double precision algorithms, written
+ * with GCC vector extensions in the same way as v_mathf.h. Two lanes
+ * matches the width of the SIMD units that handle doubles on most
+ * targets. Results match the scalar functions for ordinary arguments;
+ * special cases are recomputed with the scalar function.
+ *
+ * Where the scalar code branches on the argument range, each lane
+ * computes every branch and selects the matching result, so the
+ * cores stay free of lane-dependent control flow.
+ *
+ * These are used to build the array functions (__vexp and friends).
+ */
+
+#ifndef _V_MATH_H_
+#define _V_MATH_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "math_config.h"
+
+typedef double v2df __attribute__ ((__vector_size__ (16)));
+typedef int64_t v2di __attribute__ ((__vector_size__ (16)));
+typedef uint64_t v2du __attribute__ ((__vector_size__ (16)));
+
+#if EXP_POLY_ORDER != 5 || EXP2_POLY_ORDER != 5 || LOG_TABLE_BITS != 7 \
+  || LOG_POLY_ORDER != 6 || LOG_POLY1_ORDER != 12 || POW_LOG_POLY_ORDER != 8
+#error v_math.h does not match the configuration in math_config.h
+#endif
+
+#if defined(__has_builtin) && __has_builtin(__builtin_convertvector)
+#define v_convert2(x, t)	__builtin_convertvector (x, t)
+#else
+#define v_convert2(x, t)	((t) { (x)[0], (x)[1] })
+#endif
+
+static __always_inline int
+v_any2 (v2di m)
+{
+  return (m[0] | m[1]) != 0;
+}
+
+/* Replace the lanes of x selected by m with the value v */
+static __always_inline v2du
+v_sel2 (v2di m, uint64_t v, v2du x)
+{
+  return (x & ~(v2du) m) | ((v2du) m & v);
+}
+
+/* Replace the lanes of a selected by m with those of b */
+static __always_inline v2df
+v_merge2 (v2di m, v2df a, v2df b)
+{
+  return (v2df) (((v2du) a & ~(v2du) m) | ((v2du) b & (v2du) m));
+}
+
+static __always_inline v2df
+v_fixup (v2df r, v2df x, v2di special, double (*f) (double))
+{
+  int i;
+
+  if (unlikely (v_any2 (special)))
+    for (i = 0; i < 2; i++)
+      if (special[i])
+	r[i] = f (x[i]);
+  return r;
+}
+
+static __always_inline v2df
+v_fixup2 (v2df r, v2df x, v2df y, v2di special, double (*f) (double, double))
+{
+  int i;
+
+  if (unlikely (v_any2 (special)))
+    for (i = 0; i < 2; i++)
+      if (special[i])
+	r[i] = f (x[i], y[i]);
+  return r;
+}
+
+/* See exp.c. Tiny arguments take the ordinary path. */
+static __always_inline v2df
+v_exp (v2df x)
+{
+  const uint64_t *T = __exp_data.tab;
+  const double *C = __exp_data.poly;
+  const int N = 1 << EXP_TABLE_BITS;
+  v2du ix = (v2du) x;
+  v2di special;
+  v2du ki, idx, sbits;
+  v2df xd, z, kd, r, r2, tail, tmp, scale;
+
+  /* |x| >= 512 or x is nan, compared as doubles as SSE2 lacks 64-bit
+     integer comparisons */
+  special = ~(v2di) ((v2df) (ix & 0x7fffffffffffffff) < 512.0);
+  xd = (v2df) v_sel2 (special, 0, ix);
+
+  /* x = ln2/N*k + r, with int k and r in [-ln2/2N, ln2/2N].  */
+  z = __exp_data.invln2N * xd;
+  kd = z + __exp_data.shift;
+  ki = (v2du) kd;
+  kd -= __exp_data.shift;
+  r = xd + kd * __exp_data.negln2hiN + kd * __exp_data.negln2loN;
+
+  /* 2^(k/N) ~= scale * (1 + tail).  */
+  idx = 2 * (ki % N);
+  tail = (v2df) (v2du) { T[idx[0]], T[idx[1]] };
+  sbits = (v2du) { T[idx[0] + 1], T[idx[1] + 1] } + (ki << (52 - EXP_TABLE_BITS));
+
+  /* exp(x) = 2^(k/N) * exp(r) ~= scale + scale * (tail + exp(r) - 1).  */
+  r2 = r * r;
+  tmp = tail + r + r2 * (C[0] + r * C[1]) + r2 * r2 * (C[2] + r * C[3]);
+  scale = (v2df) sbits;
+  return v_fixup (scale + scale * tmp, x, special, exp);
+}
+
+/* See exp2.c */
+static __always_inline v2df
+v_exp2 (v2df x)
+{
+  const uint64_t *T = __exp_data.tab;
+  const double *C = __exp_data.exp2_poly;
+  const int N = 1 << EXP_TABLE_BITS;
+  v2du ix = (v2du) x;
+  v2di special;
+  v2du ki, idx, sbits;
+  v2df xd, kd, r, r2, tail, tmp, scale;
+
+  /* |x| >= 512 or x is nan */
+  special = ~(v2di) ((v2df) (ix & 0x7fffffffffffffff) < 512.0);
+  xd = (v2df) v_sel2 (special, 0, ix);
+
+  /* x = k/N + r, with int k and r in [-1/2N, 1/2N].  */
+  kd = xd + __exp_data.exp2_shift;
+  ki = (v2du) kd;
+  kd -= __exp_data.exp2_shift;
+  r = xd - kd;
+
+  /* 2^(k/N) ~= scale * (1 + tail).  */
+  idx = 2 * (ki % N);
+  tail = (v2df) (v2du) { T[idx[0]], T[idx[1]] };
+  sbits = (v2du) { T[idx[0] + 1], T[idx[1] + 1] } + (ki << (52 - EXP_TABLE_BITS));
+
+  /* exp2(x) = 2^(k/N) * 2^r ~= scale + scale * (tail + 2^r - 1).  */
+  r2 = r * r;
+  tmp = tail + r * C[0] + r2 * (C[1] + r * C[2]) + r2 * r2 * (C[3] + r * C[4]);
+  scale = (v2df) sbits;
+  return v_fixup (scale + scale * tmp, x, special, exp2);
+}
+
+/* See log.c. Inputs near 1.0 use the second polynomial. */
+static __always_inline v2df
+v_log (v2df x)
+{
+  const double *A = __log_data.poly;
+  const double *B = __log_data.poly1;
+  const uint64_t OFF = 0x3fe6000000000000;
+  const int N = 1 << LOG_TABLE_BITS;
+  v2du ix, tmp, i, iz;
+  v2di special, near, k;
+  v2df xd, z, r, r2, r3, invc, logc, kd, w, hi, lo, rhi, rlo, y, y1;
+
+  /* x < 0x1p-1022 or inf or nan */
+  special = ~(v2di) ((x >= 0x1p-1022) & (x < (double) INFINITY));
+#if WANT_ROUNDING
+  /* Fix sign of zero with downward rounding when x==1 */
+  special |= (v2di) (x == 1.0);
+#endif
+  ix = v_sel2 (special, 0x4000000000000000, (v2du) x);
+  xd = (v2df) ix;
+
+  /* Close to 1.0 */
+  near = (v2di) ((xd >= 1.0 - 0x1p-4) & (xd < 1.0 + 0x1.09p-4));
+  r = xd - 1.0;
+  r2 = r * r;
+  r3 = r * r2;
+  y1 = r3 * (B[1] + r * B[2] + r2 * B[3]
+	     + r3 * (B[4] + r * B[5] + r2 * B[6]
+		     + r3 * (B[7] + r * B[8] + r2 * B[9] + r3 * B[10])));
+  w = r * 0x1p27;
+  rhi = r + w - w;
+  rlo = r - rhi;
+  w = rhi * rhi * B[0]; /* B[0] == -0.5.  */
+  hi = r + w;
+  lo = r - hi + w;
+  lo += B[0] * rlo * (rhi + r);
+  y1 += lo;
+  y1 += hi;
+
+  /* x = 2^k z; where z is in range [OFF,2*OFF) and exact.  */
+  tmp = ix - OFF;
+  i = (tmp >> (52 - LOG_TABLE_BITS)) % N;
+  k = (v2di) tmp >> 52;
+  iz = ix - (tmp & 0xfffULL << 52);
+  invc = (v2df) { __log_data.tab[i[0]].invc, __log_data.tab[i[1]].invc };
+  logc = (v2df) { __log_data.tab[i[0]].logc, __log_data.tab[i[1]].logc };
+  z = (v2df) iz;
+
+  /* r ~= z/c - 1, |r| < 1/(2*N).  */
+#if __HAVE_FAST_FMA
+  r = (v2df) { fma (z[0], invc[0], -1.0), fma (z[1], invc[1], -1.0) };
+#else
+  r = (z - (v2df) { __log_data.tab2[i[0]].chi, __log_data.tab2[i[1]].chi }
+       - (v2df) { __log_data.tab2[i[0]].clo, __log_data.tab2[i[1]].clo }) * invc;
+#endif
+  kd = v_convert2 (k, v2df);
+
+  /* hi + lo = r + log(c) + k*Ln2.  */
+  w = kd * __log_data.ln2hi + logc;
+  hi = w + r;
+  lo = w - hi + r + kd * __log_data.ln2lo;
+
+  /* log(x) = lo + (log1p(r) - r) + hi.  */
+  r2 = r * r;
+  y = lo + r2 * A[0] + r * r2 * (A[1] + r * A[2] + r2 * (A[3] + r * A[4])) + hi;
+
+  return v_fixup (v_merge2 (near, y, y1), x, special, log);
+}
+
+/*
+ * See pow.c. Negative x, special y and results which may overflow or
+ * underflow are left to pow.
+ */
+static __always_inline v2df
+v_pow (v2df x, v2df y)
+{
+  const double *A = __pow_log_data.poly;
+  const uint64_t OFF = 0x3fe6955500000000;
+  const int LN = 1 << POW_LOG_TABLE_BITS;
+  const uint64_t *T = __exp_data.tab;
+  const double *C = __exp_data.poly;
+  const int N = 1 << EXP_TABLE_BITS;
+  v2du ix, iy, tmp, i, iz, ki, idx, sbits;
+  v2di special, k;
+  v2df ay, yd, z, kd, invc, logc, logctail, r, t1, t2, lo1, lo2, lo3, lo4;
+  v2df ar, ar2, ar3, hi, lo, p, l, ltail, ehi, elo, r2, tail, tmp2, scale;
+
+  /* x is not a positive normal, or |y| < 0x1p-65 or |y| >= 0x1p63 or nan */
+  ay = (v2df) ((v2du) y & 0x7fffffffffffffff);
+  special = ~(v2di) ((x >= 0x1p-1022) & (x < (double) INFINITY)
+		     & (ay >= 0x1p-65) & (ay < 0x1p63));
+  ix = v_sel2 (special, 0x3ff0000000000000, (v2du) x);
+  iy = v_sel2 (special, 0x3ff0000000000000, (v2du) y);
+  yd = (v2df) iy;
+
+  /* log(x) = k*Ln2 + log(c) + log1p(z/c-1), see log_inline.  */
+  tmp = ix - OFF;
+  i = (tmp >> (52 - POW_LOG_TABLE_BITS)) % LN;
+  k = (v2di) tmp >> 52;
+  iz = ix - (tmp & 0xfffULL << 52);
+  z = (v2df) iz;
+  kd = v_convert2 (k, v2df);
+#define POW_T(n) __pow_log_data.tab[i[n]]
+  invc = (v2df) { POW_T(0).invc, POW_T(1).invc };
+  logc = (v2df) { POW_T(0).logc, POW_T(1).logc };
+  logctail = (v2df) { POW_T(0).logctail, POW_T(1).logctail };
+#undef POW_T
+
+#if __HAVE_FAST_FMA
+  r = (v2df) { fma (z[0], invc[0], -1.0), fma (z[1], invc[1], -1.0) };
+#else
+  /* Split z such that rhi, rlo and rhi*rhi are exact and |rlo| <= |r|.  */
+  v2df zhi = (v2df) ((iz + (1ULL << 31)) & (-1ULL << 32));
+  v2df zlo = z - zhi;
+  v2df rhi = zhi * invc - 1.0;
+  v2df rlo = zlo * invc;
+  r = rhi + rlo;
+#endif
+
+  /* k*Ln2 + log(c) + r.  */
+  t1 = kd * __pow_log_data.ln2hi + logc;
+  t2 = t1 + r;
+  lo1 = kd * __pow_log_data.ln2lo + logctail;
+  lo2 = t1 - t2 + r;
+  ar = A[0] * r; /* A[0] = -0.5.  */
+  ar2 = r * ar;
+  ar3 = r * ar2;
+
+  /* k*Ln2 + log(c) + r + A[0]*r*r.  */
+#if __HAVE_FAST_FMA
+  hi = t2 + ar2;
+  lo3 = (v2df) { fma (ar[0], r[0], -ar2[0]), fma (ar[1], r[1], -ar2[1]) };
+  lo4 = t2 - hi + ar2;
+#else
+  v2df arhi = A[0] * rhi;
+  v2df arhi2 = rhi * arhi;
+  hi = t2 + arhi2;
+  lo3 = rlo * (ar + arhi);
+  lo4 = t2 - hi + arhi2;
+#endif
+
+  /* p = log1p(r) - r - A[0]*r*r.  */
+  p = (ar3
+       * (A[1] + r * A[2] + ar2 * (A[3] + r * A[4] + ar2 * (A[5] + r * A[6]))));
+  lo = lo1 + lo2 + lo3 + lo4 + p;
+  l = hi + lo;
+  ltail = hi - l + lo;
+
+  /* ehi + elo = y * log(x).  */
+#if __HAVE_FAST_FMA
+  ehi = yd * l;
+  elo = yd * ltail + (v2df) { fma (yd[0], l[0], -ehi[0]),
+			      fma (yd[1], l[1], -ehi[1]) };
+#else
+  v2df yhi = (v2df) (iy & -1ULL << 27);
+  v2df ylo = yd - yhi;
+  v2df lhi = (v2df) ((v2du) l & -1ULL << 27);
+  v2df llo = l - lhi + ltail;
+  ehi = yhi * lhi;
+  elo = ylo * lhi + yd * llo;
+#endif
+
+  /* exp(ehi + elo), see exp_inline. |ehi| < 0x1p-54 or |ehi| >= 512 */
+  ay = (v2df) ((v2du) ehi & 0x7fffffffffffffff);
+  special |= ~(v2di) ((ay >= 0x1p-54) & (ay < 512.0));
+  ehi = (v2df) v_sel2 (special, 0, (v2du) ehi);
+  elo = (v2df) v_sel2 (special, 0, (v2du) elo);
+
+  z = __exp_data.invln2N * ehi;
+  kd = z + __exp_data.shift;
+  ki = (v2du) kd;
+  kd -= __exp_data.shift;
+  r = ehi + kd * __exp_data.negln2hiN + kd * __exp_data.negln2loN;
+  r += elo;
+
+  /* 2^(k/N) ~= scale * (1 + tail).  */
+  idx = 2 * (ki % N);
+  tail = (v2df) (v2du) { T[idx[0]], T[idx[1]] };
+  sbits = (v2du) { T[idx[0] + 1], T[idx[1] + 1] } + (ki << (52 - EXP_TABLE_BITS));
+
+  r2 = r * r;
+  tmp2 = tail + r + r2 * (C[0] + r * C[1]) + r2 * r2 * (C[2] + r * C[3]);
+  scale = (v2df) sbits;
+  return v_fixup2 (scale + scale * tmp2, x, y, special, pow);
+}
+
+/*
+ * Shared by sin and cos, see s_sin.c, s_cos.c, k_sin.c, k_cos.c and
+ * s_rem_pio2.c. Arguments up to 2^19*pi/2 take the medium reduction,
+ * which gives the same y[0] and y[1] as the |x| < 3pi/4 shortcut;
+ * lanes needing the second reduction step, near pi/2 or larger go to
+ * the scalar function. Set 'cosine' to compute the cosine.
+ */
+static __always_inline v2df
+v_sincos (v2df x, int cosine)
+{
+  /* See s_rem_pio2.c */
+  const double invpio2 = 6.36619772367581382433e-01; /* 0x3FE45F30, 0x6DC9C883 */
+  const double pio2_1 = 1.57079632673412561417e+00; /* 0x3FF921FB, 0x54400000 */
+  const double pio2_1t = 6.07710050650619224932e-11; /* 0x3DD0B461, 0x1A626331 */
+  /* See k_sin.c */
+  const double S1 = -1.66666666666666324348e-01; /* 0xBFC55555, 0x55555549 */
+  const double S2 = 8.33333333332248946124e-03; /* 0x3F811111, 0x1110F8A6 */
+  const double S3 = -1.98412698298579493134e-04; /* 0xBF2A01A0, 0x19C161D5 */
+  const double S4 = 2.75573137070700676789e-06; /* 0x3EC71DE3, 0x57B1FE7D */
+  const double S5 = -2.50507602534068634195e-08; /* 0xBE5AE5E6, 0x8A2B9CEB */
+  const double S6 = 1.58969099521155010221e-10; /* 0x3DE5D93A, 0x5ACFD57C */
+  /* See k_cos.c */
+  const double C1 = 4.16666666666666019037e-02; /* 0x3FA55555, 0x5555554C */
+  const double C2 = -1.38888888888741095749e-03; /* 0xBF56C16C, 0x16C15177 */
+  const double C3 = 2.48015872894767294178e-05; /* 0x3EFA01A0, 0x19CB1590 */
+  const double C4 = -2.75573143513906633035e-07; /* 0xBE927E4F, 0x809C52AD */
+  const double C5 = 2.08757232129817482790e-09; /* 0x3E21EE9E, 0xBDB4B1C4 */
+  const double C6 = -1.13596475577881948265e-11; /* 0xBDA8FAE9, 0xBE8838D4 */
+  v2du ix = (v2du) x;
+  v2du sign = ix & 0x8000000000000000;
+  v2di special, small, tiny, n, neg, q;
+  v2du qx;
+  v2df t, fn, r, w, y0, y1, ay, z, v, rs, rc, s, c;
+
+  /* |x| >= 2^19*pi/2 or inf or nan, or |x| near pi/2 */
+  t = (v2df) (ix ^ sign);
+  special = ~(v2di) (t < 0x1.921fcp+20);
+  special |= (v2di) ((t >= 0x1.921fbp+0) & (t < 0x1.921fcp+0));
+  t = (v2df) v_sel2 (special, 0x3ff0000000000000, (v2du) t);
+
+  /* |x| ~<= pi/4 needs no reduction */
+  small = (v2di) (t < 0x1.921fcp-1);
+  n = v_convert2 (t * invpio2 + 0.5, v2di) & ~small;
+  fn = v_convert2 (n, v2df);
+  r = t - fn * pio2_1;
+  w = fn * pio2_1t;
+  y0 = r - w;
+  /* The 1st round lost too many bits to cancellation */
+  special |= (v2di) (((v2du) t >> 52) - (((v2du) y0 >> 52) & 0x7ff)) > 16;
+  y1 = (r - y0) - w;
+
+  /* Restore the sign of x */
+  neg = (v2di) ix >> 63;
+  y0 = (v2df) ((v2du) y0 ^ sign);
+  y1 = (v2df) ((v2du) y1 ^ sign);
+  n = (n ^ neg) - neg;
+
+  ay = (v2df) ((v2du) y0 & 0x7fffffffffffffff);
+  tiny = (v2di) (ay < 0x1p-27);
+  z = y0 * y0;
+
+  /* __kernel_sin, with iy == 0 for the unreduced lanes */
+  v = z * y0;
+  rs = S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)));
+  s = v_merge2 (small,
+		y0 - ((z * (0.5 * y1 - v * rs) - y1) - v * S1),
+		y0 + v * (S1 + z * rs));
+  s = v_merge2 (tiny, s, y0);
+
+  /* __kernel_cos; qx is zero for |y0| < 0.3 */
+  rc = z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6)))));
+  qx = ((v2du) ay & 0xffffffff00000000) - (0x00200000ULL << 32);
+  qx = v_sel2 ((v2di) (ay < 0x1.33333p-2), 0, qx);
+  qx = v_sel2 ((v2di) (ay >= 0x1.90001p-1), 0x3fd2000000000000, qx);
+  c = (1.0 - (v2df) qx) - ((0.5 * z - (v2df) qx) - (z * rc - y0 * y1));
+  c = (v2df) v_sel2 (tiny, 0x3ff0000000000000, (v2du) c);
+
+  /* Odd quadrants swap the kernels, the result is negated in quadrants 2 and 3 */
+  q = n + cosine;
+  s = v_merge2 ((q & 1) != 0, s, c);
+  s = (v2df) ((v2du) s ^ ((v2du) (q & 2) << 62));
+  return v_fixup (s, x, special, cosine ? cos : sin);
+}
+
+static __always_inline v2df
+v_sin (v2df x)
+{
+  return v_sincos (x, 0);
+}
+
+static __always_inline v2df
+v_cos (v2df x)
+{
+  return v_sincos (x, 1);
+}
+
+/*
+ * See s_expm1.c. This only covers the arguments v_tanh passes in,
+ * 2^-54 <= |x| < 44, where the scalar code always reaches the
+ * polynomial.
+ */
+static __always_inline v2df
+v_expm1 (v2df x)
+{
+  const double ln2_hi = 6.93147180369123816490e-01; /* 0x3fe62e42, 0xfee00000 */
+  const double ln2_lo = 1.90821492927058770002e-10; /* 0x3dea39ef, 0x35793c76 */
+  const double invln2 = 1.44269504088896338700e+00; /* 0x3ff71547, 0x652b82fe */
+  const double Q1 = -3.33333333333331316428e-02; /* BFA11111 111110F4 */
+  const double Q2 = 1.58730158725481460165e-03; /* 3F5A01A0 19FE5585 */
+  const double Q3 = -7.93650757867487942473e-05; /* BF14CE19 9EAADBB7 */
+  const double Q4 = 4.00821782732936239552e-06; /* 3ED0CFCA 86E65239 */
+  const double Q5 = -2.01099218183624371326e-07; /* BE8AFDB7 6E09C32D */
+  v2du ix = (v2du) x;
+  v2du sign = ix & 0x8000000000000000;
+  v2di k;
+  v2du kbits, ks;
+  v2df t, hi, lo, c, hfx, hxs, r1, e, y, y1;
+
+  /* |x| > 0.5 ln2 needs reduction, k = 1 and -1 match the general case */
+  k = v_convert2 (invln2 * x + (v2df) (sign | 0x3fe0000000000000), v2di);
+  k &= (v2di) ((v2df) (ix ^ sign) >= 0x1.62e43p-2);
+  t = v_convert2 (k, v2df);
+  hi = x - t * ln2_hi; /* t*ln2_hi is exact here */
+  lo = t * ln2_lo;
+  x = hi - lo;
+  c = (hi - x) - lo;
+
+  /* x is now in primary range */
+  hfx = 0.5 * x;
+  hxs = x * hfx;
+  r1 = 1.0 + hxs * (Q1 + hxs * (Q2 + hxs * (Q3 + hxs * (Q4 + hxs * Q5))));
+  t = 3.0 - r1 * hfx;
+  e = hxs * ((r1 - t) / (6.0 - x * t));
+  y1 = x - (x * e - hxs); /* k == 0, c is 0 */
+  e = (x * (e - c) - c);
+  e -= hxs;
+
+  /* Add k to the exponent of the result */
+  kbits = (v2du) k << 52;
+  ks = (v2du) k & 63;
+
+  /* 20 <= k <= 56 */
+  y = x - (e + (v2df) ((0x3ff - (v2du) k) << 52));
+  y += 1.0;
+  y = (v2df) ((v2du) y + kbits);
+  /* 2 <= k < 20, with 1-2^-k */
+  y = v_merge2 (k < 20, y,
+		(v2df) ((v2du) ((v2df) (0x3ff0000000000000 - (0x0020000000000000 >> ks))
+				- (e - x)) + kbits));
+  /* k <= -2 || k > 56 */
+  y = v_merge2 ((k <= -2) | (k > 56), y,
+		(v2df) ((v2du) (1.0 - (e - x)) + kbits) - 1.0);
+  y = v_merge2 (k == 1, y,
+		v_merge2 ((v2di) (x < -0.25), 1.0 + 2.0 * (x - e),
+			  -2.0 * (e - (x + 0.5))));
+  y = v_merge2 (k == -1, y, 0.5 * (x - e) - 0.5);
+  return v_merge2 (k == 0, y, y1);
+}
+
+/* See s_tanh.c */
+static __always_inline v2df
+v_tanh (v2df x)
+{
+  v2du ix = (v2du) x;
+  v2du sign = ix & 0x8000000000000000;
+  v2di special, tiny, huge, big;
+  v2df ax, t, z;
+
+  /* x is inf or nan */
+  ax = (v2df) (ix ^ sign);
+  special = ~(v2di) (ax < (double) INFINITY);
+  tiny = (v2di) (ax < 0x1p-55);
+  huge = (v2di) (ax >= 22.0);
+  big = (v2di) (ax >= 1.0);
+  ax = (v2df) v_sel2 (special | tiny | huge, 0x3ff0000000000000, (v2du) ax);
+
+  /* expm1(2|x|) for |x| >= 1, expm1(-2|x|) otherwise */
+  t = v_expm1 ((v2df) ((v2du) (2.0 * ax) | (~(v2du) big & 0x8000000000000000)));
+  z = v_merge2 (big, -t / (t + 2.0), 1.0 - 2.0 / (t + 2.0));
+
+  /* |x| >= 22 returns +-1, tiny |x| returns x * (1 + x) */
+  z = (v2df) v_sel2 (huge, 0x3ff0000000000000, (v2du) z);
+  z = (v2df) ((v2du) z ^ sign);
+  z = v_merge2 (tiny, z, x * (1.0 + x));
+  return v_fixup (z, x, special, tanh);
+}
+
+/* Array versions of the cores, as in v_mathf.h */
+static __always_inline void
+v_batch1 (double *out, const double *in, size_t n, v2df (*core) (v2df))
+{
+  v2df x;
+
+  for (; n >= 2; n -= 2, in += 2, out += 2)
+    {
+      memcpy (&x, in, sizeof (x));
+      x = core (x);
+      memcpy (out, &x, sizeof (x));
+    }
+  if (n)
+    {
+      x = (v2df) { in[0], 1.0 };
+      x = core (x);
+      out[0] = x[0];
+    }
+}
+
+static __always_inline void
+v_batch2 (double *out, const double *in0, const double *in1, size_t n,
+	  v2df (*core) (v2df, v2df))
+{
+  v2df x, y;
+
+  for (; n >= 2; n -= 2, in0 += 2, in1 += 2, out += 2)
+    {
+      memcpy (&x, in0, sizeof (x));
+      memcpy (&y, in1, sizeof (y));
+      x = core (x, y);
+      memcpy (out, &x, sizeof (x));
+    }
+  if (n)
+    {
+      x = (v2df) { in0[0], 1.0 };
+      y = (v2df) { in1[0], 1.0 };
+      x = core (x, y);
+      out[0] = x[0];
+    }
+}
+
+#endif /* _V_MATH_H_ */
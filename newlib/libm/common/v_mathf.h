@@ -0,0 +1,617 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Lane-parallel versions of the sinf, cosf, expf, exp2f, logf and
+ * powf algorithms, written with GCC vector extensions. They use the
+ * same tables and polynomials as the scalar code and produce the same
+ * results for ordinary arguments. tanhf is computed differently, see
+ * v_tanhf. Lanes holding special cases
+ * (overflow, underflow, invalid or very large arguments) are
+ * recomputed with the scalar function, which also takes care of
+ * errno and exceptions for those lanes.
+ *
+ * These are used to build the vector function ABI entry points
+ * (_ZGVbN4v_sinf and friends) called from loops vectorized by the
+ * compiler, and the array functions (__vsinf and friends).
+ */
+
+#ifndef _V_MATHF_H_
+#define _V_MATHF_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "math_config.h"
+#include "sincosf.h"
+
+typedef float v4sf __attribute__ ((__vector_size__ (16)));
+typedef int32_t v4si __attribute__ ((__vector_size__ (16)));
+typedef uint32_t v4su __attribute__ ((__vector_size__ (16)));
+typedef double v4df __attribute__ ((__vector_size__ (32)));
+typedef int64_t v4di __attribute__ ((__vector_size__ (32)));
+typedef uint64_t v4du __attribute__ ((__vector_size__ (32)));
+
+/* Rounds a double in [-2^51, 2^51] to an integer in the low bits */
+#define V_TOINT_SHIFT 0x1.8p52
+
+/*
+ * Conversions between the 32- and 64-bit lane types. These are macros
+ * as functions taking or returning 32-byte vectors would trip ABI
+ * warnings on targets without 256-bit registers.
+ */
+#if defined(__has_builtin) && __has_builtin(__builtin_convertvector)
+#define v_convert(x, t)	__builtin_convertvector (x, t)
+#else
+#define v_convert(x, t)	((t) { (x)[0], (x)[1], (x)[2], (x)[3] })
+#endif
+#define v_f2d(x)	v_convert (x, v4df)
+#define v_d2f(x)	v_convert (x, v4sf)
+#define v_i2d(x)	v_convert (x, v4df)
+#define v_s32to64(x)	v_convert (x, v4di)
+
+/* Narrow 64-bit lanes to their low 32 bits */
+#define v_64to32(x)	v_convert (x, v4si)
+
+static __always_inline int
+v_any (v4si m)
+{
+  typedef uint64_t v2du __attribute__ ((__vector_size__ (16)));
+  v2du t = (v2du) m;
+
+  return (t[0] | t[1]) != 0;
+}
+
+/* Replace the lanes of x selected by m with the value v */
+static __always_inline v4su
+v_sel (v4si m, uint32_t v, v4su x)
+{
+  return (x & ~(v4su) m) | ((v4su) m & v);
+}
+
+static __always_inline v4sf
+v_fixup1 (v4sf r, v4sf x, v4si special, float (*f) (float))
+{
+  int i;
+
+  if (unlikely (v_any (special)))
+    for (i = 0; i < 4; i++)
+      if (special[i])
+	r[i] = f (x[i]);
+  return r;
+}
+
+static __always_inline v4sf
+v_fixup2 (v4sf r, v4sf x, v4sf y, v4si special, float (*f) (float, float))
+{
+  int i;
+
+  if (unlikely (v_any (special)))
+    for (i = 0; i < 4; i++)
+      if (special[i])
+	r[i] = f (x[i], y[i]);
+  return r;
+}
+
+/* See sf_exp.c */
+static __always_inline v4sf
+v_expf (v4sf x)
+{
+  const uint64_t *T = __exp2f_data.tab;
+  const double *C = __exp2f_data.poly_scaled;
+  const int N = 1 << EXP2F_TABLE_BITS;
+  v4su ix = (v4su) x;
+  v4si special;
+  v4du ki, t;
+  v4df xd, z, kd, r, r2, y, s;
+
+  /* |x| >= 88 or x is nan */
+  special = (v4si) (((ix >> 20) & 0x7ff) >= (asuint (88.0f) >> 20));
+  xd = v_f2d ((v4sf) v_sel (special, 0, ix));
+
+  /* x*N/Ln2 = k + r with r in [-1/2, 1/2] and int k.  */
+  z = __exp2f_data.invln2_scaled * xd;
+  kd = z + __exp2f_data.shift;
+  ki = (v4du) kd;
+  kd -= __exp2f_data.shift;
+  r = z - kd;
+
+  /* exp(x) = 2^(k/N) * 2^(r/N) ~= s * (C0*r^3 + C1*r^2 + C2*r + 1) */
+  t = (v4du) { T[ki[0] % N], T[ki[1] % N], T[ki[2] % N], T[ki[3] % N] };
+  t += ki << (52 - EXP2F_TABLE_BITS);
+  s = (v4df) t;
+  z = C[0] * r + C[1];
+  r2 = r * r;
+  y = C[2] * r + 1.0;
+  y = z * r2 + y;
+  y = y * s;
+  return v_fixup1 (v_d2f (y), x, special, expf);
+}
+
+/* See sf_exp2.c */
+static __always_inline v4sf
+v_exp2f (v4sf x)
+{
+  const uint64_t *T = __exp2f_data.tab;
+  const double *C = __exp2f_data.poly;
+  const int N = 1 << EXP2F_TABLE_BITS;
+  v4su ix = (v4su) x;
+  v4si special;
+  v4du ki, t;
+  v4df xd, kd, z, r, r2, y, s;
+
+  /* |x| >= 128 or x is nan */
+  special = (v4si) (((ix >> 20) & 0x7ff) >= (asuint (128.0f) >> 20));
+  xd = v_f2d ((v4sf) v_sel (special, 0, ix));
+
+  /* x = k/N + r with r in [-1/(2N), 1/(2N)] and int k.  */
+  kd = xd + __exp2f_data.shift_scaled;
+  ki = (v4du) kd;
+  kd -= __exp2f_data.shift_scaled;
+  r = xd - kd;
+
+  /* exp2(x) = 2^(k/N) * 2^r ~= s * (C0*r^3 + C1*r^2 + C2*r + 1) */
+  t = (v4du) { T[ki[0] % N], T[ki[1] % N], T[ki[2] % N], T[ki[3] % N] };
+  t += ki << (52 - EXP2F_TABLE_BITS);
+  s = (v4df) t;
+  z = C[0] * r + C[1];
+  r2 = r * r;
+  y = C[2] * r + 1.0;
+  y = z * r2 + y;
+  y = y * s;
+  return v_fixup1 (v_d2f (y), x, special, exp2f);
+}
+
+/*
+ * sf_tanh.c builds on expm1f, which has no table driven version, so
+ * this evaluates tanh(|x|) in double precision instead: the Taylor
+ * series below 0.3 and 1 - 2/(exp(2|x|) + 1) above, with exp computed
+ * as in v_expf. Arguments are clamped at 16 where tanhf is 1.
+ */
+static __always_inline v4sf
+v_tanhf (v4sf x)
+{
+  const uint64_t *T = __exp2f_data.tab;
+  const double *C = __exp2f_data.poly_scaled;
+  const int N = 1 << EXP2F_TABLE_BITS;
+  v4su ix = (v4su) x;
+  v4su ia = ix & 0x7fffffff;
+  v4si special;
+  v4du small, ki, t;
+  v4df a, a2, p, z, kd, r, r2, y, s;
+
+  /* x is nan */
+  special = (v4si) (ia > 0x7f800000);
+  ia = v_sel ((v4si) (ia > asuint (16.0f)), asuint (16.0f), ia);
+  ia = v_sel (special, 0, ia);
+  a = v_f2d ((v4sf) ia);
+  small = (v4du) v_s32to64 ((v4si) (ia < asuint (0.3f)));
+
+  /* tanh(a) = a + a^3 * P(a^2), the error is below 2^-38 */
+  a2 = a * a;
+  p = a2 * (-929569.0 / 638512875.0) + (21844.0 / 6081075.0);
+  p = a2 * p + (-1382.0 / 155925.0);
+  p = a2 * p + (62.0 / 2835.0);
+  p = a2 * p + (-17.0 / 315.0);
+  p = a2 * p + (2.0 / 15.0);
+  p = a2 * p + (-1.0 / 3.0);
+  p = a * a2 * p + a;
+
+  /* exp(2a) = 2^(k/N) * 2^(r/N) */
+  z = __exp2f_data.invln2_scaled * (a + a);
+  kd = z + __exp2f_data.shift;
+  ki = (v4du) kd;
+  kd -= __exp2f_data.shift;
+  r = z - kd;
+  t = (v4du) { T[ki[0] % N], T[ki[1] % N], T[ki[2] % N], T[ki[3] % N] };
+  t += ki << (52 - EXP2F_TABLE_BITS);
+  s = (v4df) t;
+  z = C[0] * r + C[1];
+  r2 = r * r;
+  y = C[2] * r + 1.0;
+  y = z * r2 + y;
+  y = y * s;
+  y = 1.0 - 2.0 / (y + 1.0);
+
+  y = (v4df) (((v4du) p & small) | ((v4du) y & ~small));
+  return v_fixup1 ((v4sf) ((v4su) v_d2f (y) | (ix & 0x80000000)),
+		   x, special, tanhf);
+}
+
+/* See sf_log.c */
+static __always_inline v4sf
+v_logf (v4sf x)
+{
+  const double *A = __logf_data.poly;
+  const uint32_t N = 1 << LOGF_TABLE_BITS;
+  const uint32_t OFF = 0x3f330000;
+  v4su ix = (v4su) x;
+  v4su tmp, i, iz;
+  v4si special, k;
+  v4df z, r, r2, y, y0, invc, logc;
+
+  /* x < 0x1p-126 or inf or nan */
+  special = (v4si) (ix - 0x00800000 >= 0x7f800000 - 0x00800000);
+#if WANT_ROUNDING
+  /* Fix sign of zero with downward rounding when x==1.  */
+  special |= (v4si) (ix == 0x3f800000);
+#endif
+  ix = v_sel (special, 0x3f800000, ix);
+
+  /* x = 2^k z; where z is in range [OFF,2*OFF] and exact.  */
+  tmp = ix - OFF;
+  i = (tmp >> (23 - LOGF_TABLE_BITS)) % N;
+  k = (v4si) tmp >> 23;
+  iz = ix - (tmp & (uint32_t) 0x1ff << 23);
+#define LOGF_T(n) __logf_data.tab[i[n]]
+  invc = (v4df) { LOGF_T(0).invc, LOGF_T(1).invc, LOGF_T(2).invc, LOGF_T(3).invc };
+  logc = (v4df) { LOGF_T(0).logc, LOGF_T(1).logc, LOGF_T(2).logc, LOGF_T(3).logc };
+#undef LOGF_T
+  z = v_f2d ((v4sf) iz);
+
+  /* log(x) = log1p(z/c-1) + log(c) + k*Ln2 */
+  r = z * invc - 1.0;
+  y0 = logc + v_i2d (k) * __logf_data.ln2;
+
+  r2 = r * r;
+  y = A[1] * r + A[2];
+  y = A[0] * r2 + y;
+  y = y * r2 + (y0 + r);
+  return v_fixup1 (v_d2f (y), x, special, logf);
+}
+
+/* See sf_pow.c. Negative x and special y are left to powf. */
+static __always_inline v4sf
+v_powf (v4sf x, v4sf y)
+{
+  const double *A = __powf_log2_data.poly;
+  const uint64_t *T = __exp2f_data.tab;
+  const uint32_t N = 1 << POWF_LOG2_TABLE_BITS;
+  const uint32_t OFF = 0x3f330000;
+#if TOINT_INTRINSICS
+  const double *C = __exp2f_data.poly_scaled;
+  const double shift = V_TOINT_SHIFT;
+#else
+  const double *C = __exp2f_data.poly;
+  const double shift = __exp2f_data.shift_scaled;
+#endif
+  v4su ix = (v4su) x;
+  v4su iy = (v4su) y;
+  v4su tmp, i, top, iz;
+  v4si special, k;
+  v4du ki, t;
+  v4df z, r, r2, r4, p, q, l, y0, invc, logc, ylogx, kd, s;
+
+  /* x is not a positive normal, or y is 0, inf or nan */
+  special = (v4si) (ix - 0x00800000 >= 0x7f800000 - 0x00800000);
+  special |= (v4si) (2 * iy - 1 >= 2u * 0x7f800000 - 1);
+  ix = v_sel (special, 0x3f800000, ix);
+  iy = v_sel (special, 0, iy);
+
+  /* log2(x) = log1p(z/c-1)/ln2 + log2(c) + k */
+  tmp = ix - OFF;
+  i = (tmp >> (23 - POWF_LOG2_TABLE_BITS)) % N;
+  top = tmp & 0xff800000;
+  iz = ix - top;
+  k = (v4si) top >> (23 - POWF_SCALE_BITS);
+#define POWF_T(n) __powf_log2_data.tab[i[n]]
+  invc = (v4df) { POWF_T(0).invc, POWF_T(1).invc, POWF_T(2).invc, POWF_T(3).invc };
+  logc = (v4df) { POWF_T(0).logc, POWF_T(1).logc, POWF_T(2).logc, POWF_T(3).logc };
+#undef POWF_T
+  z = v_f2d ((v4sf) iz);
+  r = z * invc - 1.0;
+  y0 = logc + v_i2d (k);
+
+  r2 = r * r;
+  l = A[0] * r + A[1];
+  p = A[2] * r + A[3];
+  r4 = r2 * r2;
+  q = A[4] * r + y0;
+  q = p * r2 + q;
+  l = l * r4 + q;
+  ylogx = v_f2d ((v4sf) iy) * l;
+
+  /* |y*log(x)| >= 126 may overflow or underflow */
+  special |= v_64to32 ((v4di) (((v4du) ylogx >> 47 & 0xffff)
+				   >= asuint64 (126.0 * POWF_SCALE) >> 47));
+  ylogx = (v4df) ((v4du) ylogx & ~(v4du) v_s32to64 (special));
+
+  /* exp2(x) = 2^(k/N) * 2^r ~= s * (C0*r^3 + C1*r^2 + C2*r + 1) */
+  kd = ylogx + shift;
+  ki = (v4du) kd;
+  kd -= shift;
+  r = ylogx - kd;
+  t = (v4du) { T[ki[0] % (1 << EXP2F_TABLE_BITS)], T[ki[1] % (1 << EXP2F_TABLE_BITS)],
+	       T[ki[2] % (1 << EXP2F_TABLE_BITS)], T[ki[3] % (1 << EXP2F_TABLE_BITS)] };
+  t += ki << (52 - EXP2F_TABLE_BITS);
+  s = (v4df) t;
+  z = C[0] * r + C[1];
+  r2 = r * r;
+  l = C[2] * r + 1.0;
+  l = z * r2 + l;
+  l = l * s;
+  return v_fixup2 (v_d2f (l), x, y, special, powf);
+}
+
+/*
+ * Shared by sinf and cosf, see sincosf.h. For |x| < 120 reduce_fast
+ * leaves arguments below pi/4 untouched with quadrant 0, so a single
+ * path covers both of the scalar fast cases. Set 'cos' to compute the
+ * cosine.
+ */
+static __always_inline v4sf
+v_sincosf (v4sf y, int cos)
+{
+  const sincos_t *p = &__sincosf_table[0];
+  v4su iy = (v4su) y;
+  v4si special, n;
+  v4du use_cos, neg;
+  v4df x, x2, x3, x4, x6, x7, r, s, c, c1, c2, s1, sn, cs;
+  v4sf res;
+
+  /* |y| >= 120 or inf or nan */
+  special = (v4si) (((iy >> 20) & 0x7ff) >= abstop12 (120.0f));
+  x = v_f2d ((v4sf) v_sel (special, 0, iy));
+
+  r = x * p->hpi_inv;
+#if TOINT_INTRINSICS
+  r += V_TOINT_SHIFT;
+  n = v_64to32 ((v4di) r);
+  r -= V_TOINT_SHIFT;
+  x = x - r * p->hpi;
+#else
+  n = v_convert (r, v4si);
+  n = (n + 0x800000) >> 24;
+  x = x - v_i2d (n) * p->hpi;
+#endif
+
+  /* Odd quadrants swap the polynomials (even ones for cosf) */
+  use_cos = (v4du) v_s32to64 ((n & 1) == (cos ? 0 : 1));
+  /* The cosine is negated in quadrants 2 and 3 */
+  neg = (v4du) (v_s32to64 (n) & 2) << 62;
+  s = (v4df) { p->sign[n[0] & 3], p->sign[n[1] & 3], p->sign[n[2] & 3], p->sign[n[3] & 3] };
+
+  x2 = x * x;
+
+  /* sine polynomial of x * s */
+  x = x * s;
+  x3 = x * x2;
+  s1 = p->s2 + x2 * p->s3;
+  x7 = x3 * x2;
+  sn = x + x3 * p->s1;
+  sn = sn + x7 * s1;
+
+  /* cosine polynomial */
+  x4 = x2 * x2;
+  c2 = p->c3 + x2 * p->c4;
+  c1 = p->c0 + x2 * p->c1;
+  x6 = x4 * x2;
+  c = c1 + x4 * p->c2;
+  cs = c + x6 * c2;
+
+  r = (v4df) ((((v4du) cs ^ neg) & use_cos) | ((v4du) sn & ~use_cos));
+  res = v_d2f (r);
+
+  /* sinf returns tiny arguments unchanged, which preserves -0 */
+  if (!cos)
+    {
+      v4si tiny = (v4si) (((iy >> 20) & 0x7ff) < abstop12 (0x1p-12f));
+      res = (v4sf) (((v4su) res & ~(v4su) tiny) | (iy & (v4su) tiny));
+    }
+  return v_fixup1 (res, y, special, cos ? cosf : sinf);
+}
+
+static __always_inline v4sf
+v_sinf (v4sf x)
+{
+  return v_sincosf (x, 0);
+}
+
+static __always_inline v4sf
+v_cosf (v4sf x)
+{
+  return v_sincosf (x, 1);
+}
+
+/*
+ * Array versions of the cores, used for __vexpf and friends. Elements
+ * are processed four at a time; the final partial vector is padded
+ * with ones, which is an ordinary argument for every core. Each
+ * vector is loaded before it is stored, so out may equal in.
+ */
+static __always_inline void
+v_batchf1 (float *out, const float *in, size_t n, v4sf (*core) (v4sf))
+{
+  v4sf x;
+
+  for (; n >= 4; n -= 4, in += 4, out += 4)
+    {
+      memcpy (&x, in, sizeof (x));
+      x = core (x);
+      memcpy (out, &x, sizeof (x));
+    }
+  if (n)
+    {
+      x = (v4sf) { 1.0f, 1.0f, 1.0f, 1.0f };
+      memcpy (&x, in, n * sizeof (float));
+      x = core (x);
+      memcpy (out, &x, n * sizeof (float));
+    }
+}
+
+static __always_inline void
+v_batchf2 (float *out, const float *in0, const float *in1, size_t n,
+	   v4sf (*core) (v4sf, v4sf))
+{
+  v4sf x, y;
+
+  for (; n >= 4; n -= 4, in0 += 4, in1 += 4, out += 4)
+    {
+      memcpy (&x, in0, sizeof (x));
+      memcpy (&y, in1, sizeof (y));
+      x = core (x, y);
+      memcpy (out, &x, sizeof (x));
+    }
+  if (n)
+    {
+      x = y = (v4sf) { 1.0f, 1.0f, 1.0f, 1.0f };
+      memcpy (&x, in0, n * sizeof (float));
+      memcpy (&y, in1, n * sizeof (float));
+      x = core (x, y);
+      memcpy (out, &x, n * sizeof (float));
+    }
+}
+
+/*
+ * Vector function ABI entry points. x86_64 needs the SSE, AVX, AVX2
+ * and AVX-512 variants as the compiler picks one to match the target
+ * ISA; the wider ones process four lanes at a time. AArch64 uses the
+ * 64- and 128-bit Advanced SIMD variants with the vector PCS, which
+ * needs GCC 9 or later. This matches the conditions under which
+ * math.h advertises them.
+ */
+#if defined(__x86_64__) && defined(__SSE2__)
+
+#define __HAVE_V_MATHF_ABI
+
+typedef float v8sf __attribute__ ((__vector_size__ (32)));
+typedef float v16sf __attribute__ ((__vector_size__ (64)));
+
+#define V_SLICE(x, o)	(v4sf) { x[o], x[o + 1], x[o + 2], x[o + 3] }
+
+#define V_MATHF_ENTRY1(name, core)					\
+v4sf _ZGVbN4v_##name (v4sf x);						\
+v4sf _ZGVbN4v_##name (v4sf x)						\
+{									\
+  return core (x);							\
+}									\
+									\
+v8sf _ZGVcN8v_##name (v8sf x) __attribute__ ((__target__ ("avx")));	\
+v8sf _ZGVcN8v_##name (v8sf x)						\
+{									\
+  v4sf a = core (V_SLICE (x, 0)), b = core (V_SLICE (x, 4));		\
+  return (v8sf) { a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3] };	\
+}									\
+									\
+v8sf _ZGVdN8v_##name (v8sf x) __attribute__ ((__target__ ("avx2")));	\
+v8sf _ZGVdN8v_##name (v8sf x)						\
+{									\
+  v4sf a = core (V_SLICE (x, 0)), b = core (V_SLICE (x, 4));		\
+  return (v8sf) { a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3] };	\
+}									\
+									\
+v16sf _ZGVeN16v_##name (v16sf x) __attribute__ ((__target__ ("avx512f"))); \
+v16sf _ZGVeN16v_##name (v16sf x)					\
+{									\
+  v4sf a = core (V_SLICE (x, 0)), b = core (V_SLICE (x, 4));		\
+  v4sf c = core (V_SLICE (x, 8)), d = core (V_SLICE (x, 12));		\
+  return (v16sf) { a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3],	\
+		   c[0], c[1], c[2], c[3], d[0], d[1], d[2], d[3] };	\
+}
+
+#define V_MATHF_ENTRY2(name, core)					\
+v4sf _ZGVbN4vv_##name (v4sf x, v4sf y);					\
+v4sf _ZGVbN4vv_##name (v4sf x, v4sf y)					\
+{									\
+  return core (x, y);							\
+}									\
+									\
+v8sf _ZGVcN8vv_##name (v8sf x, v8sf y) __attribute__ ((__target__ ("avx"))); \
+v8sf _ZGVcN8vv_##name (v8sf x, v8sf y)					\
+{									\
+  v4sf a = core (V_SLICE (x, 0), V_SLICE (y, 0));			\
+  v4sf b = core (V_SLICE (x, 4), V_SLICE (y, 4));			\
+  return (v8sf) { a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3] };	\
+}									\
+									\
+v8sf _ZGVdN8vv_##name (v8sf x, v8sf y) __attribute__ ((__target__ ("avx2"))); \
+v8sf _ZGVdN8vv_##name (v8sf x, v8sf y)					\
+{									\
+  v4sf a = core (V_SLICE (x, 0), V_SLICE (y, 0));			\
+  v4sf b = core (V_SLICE (x, 4), V_SLICE (y, 4));			\
+  return (v8sf) { a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3] };	\
+}									\
+									\
+v16sf _ZGVeN16vv_##name (v16sf x, v16sf y) __attribute__ ((__target__ ("avx512f"))); \
+v16sf _ZGVeN16vv_##name (v16sf x, v16sf y)				\
+{									\
+  v4sf a = core (V_SLICE (x, 0), V_SLICE (y, 0));			\
+  v4sf b = core (V_SLICE (x, 4), V_SLICE (y, 4));			\
+  v4sf c = core (V_SLICE (x, 8), V_SLICE (y, 8));			\
+  v4sf d = core (V_SLICE (x, 12), V_SLICE (y, 12));			\
+  return (v16sf) { a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3],	\
+		   c[0], c[1], c[2], c[3], d[0], d[1], d[2], d[3] };	\
+}
+
+#elif (__GNUC__ >= 9 || defined(__clang__)) && defined(__aarch64__) && defined(__ARM_NEON)
+
+#define __HAVE_V_MATHF_ABI
+
+typedef float v2sf __attribute__ ((__vector_size__ (8)));
+
+#define V_VPCS __attribute__ ((__aarch64_vector_pcs__))
+
+#define V_MATHF_ENTRY1(name, core)					\
+V_VPCS v4sf _ZGVnN4v_##name (v4sf x);					\
+V_VPCS v4sf _ZGVnN4v_##name (v4sf x)					\
+{									\
+  return core (x);							\
+}									\
+									\
+V_VPCS v2sf _ZGVnN2v_##name (v2sf x);					\
+V_VPCS v2sf _ZGVnN2v_##name (v2sf x)					\
+{									\
+  v4sf a = core ((v4sf) { x[0], x[1], x[0], x[1] });			\
+  return (v2sf) { a[0], a[1] };						\
+}
+
+#define V_MATHF_ENTRY2(name, core)					\
+V_VPCS v4sf _ZGVnN4vv_##name (v4sf x, v4sf y);				\
+V_VPCS v4sf _ZGVnN4vv_##name (v4sf x, v4sf y)				\
+{									\
+  return core (x, y);							\
+}									\
+									\
+V_VPCS v2sf _ZGVnN2vv_##name (v2sf x, v2sf y);				\
+V_VPCS v2sf _ZGVnN2vv_##name (v2sf x, v2sf y)				\
+{									\
+  v4sf a = core ((v4sf) { x[0], x[1], x[0], x[1] },			\
+		 (v4sf) { y[0], y[1], y[0], y[1] });			\
+  return (v2sf) { a[0], a[1] };						\
+}
+
+#endif
+
+#endif /* _V_MATHF_H_ */
@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "test.h"
+
+/*
+ * Run the test vectors through the array functions. Each argument is
+ * replicated into a short array so that both the vector loop and the
+ * tail are used; every element must produce the same bits.
+ */
+
+#ifdef __PICOLIBC__
+
+#include <string.h>
+
+#define BATCH_N 5
+
+static int batch_errors;
+
+#define BATCH_CHECK(type, o)                                            \
+    do {                                                                \
+        int _i;                                                         \
+        for (_i = 1; _i < BATCH_N; _i++)                                \
+            if (memcmp (&o[_i], &o[0], sizeof (type)) != 0)             \
+                batch_errors++;                                         \
+    } while (0)
+
+#define BATCH_TEST1(type, name, func)                                   \
+    static type name##_batch (type x)                                   \
+    {                                                                   \
+        type in[BATCH_N], out[BATCH_N];                                 \
+        int i;                                                          \
+        for (i = 0; i < BATCH_N; i++)                                   \
+            in[i] = x;                                                  \
+        func (out, in, BATCH_N);                                        \
+        BATCH_CHECK (type, out);                                        \
+        return out[0];                                                  \
+    }
+
+#define BATCH_TEST2(type, name, func)                                   \
+    static type name##_batch (type x, type y)                           \
+    {                                                                   \
+        type in0[BATCH_N], in1[BATCH_N], out[BATCH_N];                  \
+        int i;                                                          \
+        for (i = 0; i < BATCH_N; i++) {                                 \
+            in0[i] = x;                                                 \
+            in1[i] = y;                                                 \
+        }                                                               \
+        func (out, in0, in1, BATCH_N);                                  \
+        BATCH_CHECK (type, out);                                        \
+        return out[0];                                                  \
+    }
+
+/* Returns the sine and checks the cosine against the scalar result */
+#define BATCH_SINCOS(type, name, func, cosfunc)                         \
+    static type name##_batch (type x)                                   \
+    {                                                                   \
+        type in[BATCH_N], s[BATCH_N], c[BATCH_N];                       \
+        type cx = cosfunc (x);                                          \
+        int i;                                                          \
+        for (i = 0; i < BATCH_N; i++)                                   \
+            in[i] = x;                                                  \
+        func (s, c, in, BATCH_N);                                       \
+        BATCH_CHECK (type, s);                                          \
+        BATCH_CHECK (type, c);                                          \
+        if (memcmp (&c[0], &cx, sizeof (type)) != 0 &&                  \
+            !(isnan (c[0]) && isnan (cx)))                              \
+            batch_errors++;                                             \
+        return s[0];                                                    \
+    }
+
+BATCH_TEST1(double, exp, __vexp)
+BATCH_TEST1(double, log, __vlog)
+BATCH_TEST1(double, sin, __vsin)
+BATCH_TEST1(double, cos, __vcos)
+BATCH_TEST1(double, tanh, __vtanh)
+BATCH_TEST2(double, pow, __vpow)
+BATCH_SINCOS(double, sincos, __vsincos, cos)
+BATCH_TEST1(float, expf, __vexpf)
+BATCH_TEST1(float, logf, __vlogf)
+BATCH_TEST1(float, sinf, __vsinf)
+BATCH_TEST1(float, cosf, __vcosf)
+BATCH_TEST1(float, tanhf, __vtanhf)
+BATCH_TEST2(float, powf, __vpowf)
+BATCH_SINCOS(float, sincosf, __vsincosf, cosf)
+
+extern one_line_type exp_vec[], log_vec[], sin_vec[], cos_vec[], tanh_vec[], pow_vec[];
+extern one_line_type expf_vec[], logf_vec[], sinf_vec[], cosf_vec[], tanhf_vec[];
+
+void
+test_batch (int m)
+{
+    run_vector_1(m, exp_vec, (char *) exp_batch, "exp_batch", "dd");
+    run_vector_1(m, log_vec, (char *) log_batch, "log_batch", "dd");
+    run_vector_1(m, sin_vec, (char *) sin_batch, "sin_batch", "dd");
+    run_vector_1(m, cos_vec, (char *) cos_batch, "cos_batch", "dd");
+    run_vector_1(m, tanh_vec, (char *) tanh_batch, "tanh_batch", "dd");
+    run_vector_1(m, pow_vec, (char *) pow_batch, "pow_batch", "ddd");
+    run_vector_1(m, sin_vec, (char *) sincos_batch, "sincos_batch", "dd");
+    run_vector_1(m, expf_vec, (char *) expf_batch, "expf_batch", "ff");
+    run_vector_1(m, logf_vec, (char *) logf_batch, "logf_batch", "ff");
+    run_vector_1(m, sinf_vec, (char *) sinf_batch, "sinf_batch", "ff");
+    run_vector_1(m, cosf_vec, (char *) cosf_batch, "cosf_batch", "ff");
+    run_vector_1(m, tanhf_vec, (char *) tanhf_batch, "tanhf_batch", "ff");
+    run_vector_1(m, pow_vec, (char *) powf_batch, "powf_batch", "fff");
+    run_vector_1(m, sinf_vec, (char *) sincosf_batch, "sincosf_batch", "ff");
+    if (batch_errors) {
+        printf("array results inconsistent %d times\n", batch_errors);
+        inacc++;
+    }
+}
+
+#else
+
+void
+test_batch (int m)
+{
+    (void) m;
+}
+
+#endif
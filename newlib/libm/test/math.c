@@ -702,6 +702,7 @@ test_math (int vector)
   test_atanf(vector);
   test_atanh(vector);
   test_atanhf(vector);
+  test_batch(vector);
   test_ceil(vector);
   test_ceilf(vector);
   test_copysign(vector);
@@ -755,6 +756,7 @@ test_math (int vector)
   test_scalbnf(vector);
   test_sin(vector);
   test_sinf(vector);
+  test_simdf(vector);
   test_sinh(vector);
   test_sinhf(vector);
   test_sqrt(vector);
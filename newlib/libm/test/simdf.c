@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "test.h"
+
+/*
+ * Run the single-precision test vectors through the vector ABI entry
+ * points by broadcasting each argument to every lane. All lanes must
+ * produce the same bits; lane 0 is handed back to the usual checks.
+ */
+
+#if defined(__PICOLIBC__) && !__OBSOLETE_MATH_FLOAT &&                  \
+    ((defined(__x86_64__) && defined(__SSE2__)) ||                      \
+     ((__GNUC__ >= 9 || defined(__clang__)) && defined(__aarch64__) &&  \
+      defined(__ARM_NEON)))
+
+#include <string.h>
+
+typedef float v4sf __attribute__ ((__vector_size__ (16)));
+
+#ifdef __x86_64__
+#define SIMD_NAME1(name)        _ZGVbN4v_##name
+#define SIMD_NAME2(name)        _ZGVbN4vv_##name
+#define SIMD_PCS
+#else
+#define SIMD_NAME1(name)        _ZGVnN4v_##name
+#define SIMD_NAME2(name)        _ZGVnN4vv_##name
+#define SIMD_PCS                __attribute__ ((__aarch64_vector_pcs__))
+#endif
+
+static int simd_lane_errors;
+
+static float
+simd_lane0 (v4sf r)
+{
+    int i;
+
+    for (i = 1; i < 4; i++)
+        if (memcmp (&r[i], &r[0], sizeof (float)) != 0)
+            simd_lane_errors++;
+    return r[0];
+}
+
+#define SIMD_TEST1(name)                                                \
+    SIMD_PCS v4sf SIMD_NAME1(name) (v4sf x);                            \
+    static float name##_simd (float x)                                  \
+    {                                                                   \
+        return simd_lane0 (SIMD_NAME1(name) ((v4sf) { x, x, x, x }));   \
+    }
+
+#define SIMD_TEST2(name)                                                \
+    SIMD_PCS v4sf SIMD_NAME2(name) (v4sf x, v4sf y);                    \
+    static float name##_simd (float x, float y)                         \
+    {                                                                   \
+        return simd_lane0 (SIMD_NAME2(name) ((v4sf) { x, x, x, x },     \
+                                             (v4sf) { y, y, y, y }));   \
+    }
+
+SIMD_TEST1(sinf)
+SIMD_TEST1(cosf)
+SIMD_TEST1(expf)
+SIMD_TEST1(logf)
+SIMD_TEST2(powf)
+
+extern one_line_type sinf_vec[], cosf_vec[], expf_vec[], logf_vec[], pow_vec[];
+
+void
+test_simdf (int m)
+{
+    run_vector_1(m, sinf_vec, (char *) sinf_simd, "sinf_simd", "ff");
+    run_vector_1(m, cosf_vec, (char *) cosf_simd, "cosf_simd", "ff");
+    run_vector_1(m, expf_vec, (char *) expf_simd, "expf_simd", "ff");
+    run_vector_1(m, logf_vec, (char *) logf_simd, "logf_simd", "ff");
+    run_vector_1(m, pow_vec, (char *) powf_simd, "powf_simd", "fff");
+    if (simd_lane_errors) {
+        printf("vector lanes disagree %d times\n", simd_lane_errors);
+        inacc++;
+    }
+}
+
+#else
+
+void
+test_simdf (int m)
+{
+    (void) m;
+}
+
+#endif
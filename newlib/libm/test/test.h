@@ -368,6 +368,9 @@ test_atanh(int vector);
 void
 test_atanhf(int vector);
 
+void
+test_batch(int vector);
+
 void
 test_ceil(int vector);
 
@@ -515,6 +518,9 @@ test_sin(int vector);
 void
 test_sinf(int vector);
 
+void
+test_simdf(int vector);
+
 void
 test_sinh(int vector);
 
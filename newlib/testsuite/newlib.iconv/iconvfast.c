@@ -0,0 +1,226 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <iconv.h>
+#include <errno.h>
+
+/*
+ * Exercise the bulk converters used for common charset pairs:
+ * long ASCII runs mixed with multi-byte characters, round trips, and
+ * error positions for invalid input in the middle of a run.
+ */
+
+#ifdef __MB_CAPABLE
+
+static int failed;
+
+#define FAIL(...) do { printf(__VA_ARGS__); printf("\n"); failed++; } while (0)
+
+static size_t
+convert(const char *to, const char *from, const char *in, size_t inlen,
+        char *out, size_t outlen, size_t *inpos, int *err)
+{
+    iconv_t     cd = iconv_open(to, from);
+    char        *ip = (char *) in;
+    char        *op = out;
+    size_t      ret;
+
+    if (cd == (iconv_t) -1) {
+        FAIL("iconv_open(%s, %s) failed", to, from);
+        return 0;
+    }
+    errno = 0;
+    ret = iconv(cd, &ip, &inlen, &op, &outlen);
+    *err = ret == (size_t) -1 ? errno : 0;
+    *inpos = ip - in;
+    iconv_close(cd);
+    return op - out;
+}
+
+static const char bmp_text[] =
+    "The quick brown fox jumps over the lazy dog, "
+    "caf\xc3\xa9 na\xc3\xafve \xe2\x82\xac" "100 "
+    "and then some more plain ASCII text to make a long run.";
+
+#if __SIZEOF_WCHAR_T__ > 2
+static const char astral_text[] =
+    "Emoji \xf0\x9f\x98\x80 and \xf4\x8f\xbf\xbf at the end of a long run";
+#endif
+
+static size_t
+utf8_decode(const char *s, size_t len, uint32_t *cp)
+{
+    const unsigned char *u = (const unsigned char *) s;
+    size_t i = 0, n = 0;
+
+    while (i < len) {
+        uint32_t c = u[i++];
+        int more = c >= 0xf0 ? 3 : c >= 0xe0 ? 2 : c >= 0xc0 ? 1 : 0;
+        if (more)
+            c &= 0x3f >> more;
+        while (more--)
+            c = (c << 6) | (u[i++] & 0x3f);
+        cp[n++] = c;
+    }
+    return n;
+}
+
+static void
+test_round_trip(const char *cs, int width, int big, const char *utf8_text)
+{
+    static char wide[256 * 4];
+    static char back[256];
+    uint32_t    cp[256];
+    size_t      len = strlen(utf8_text);
+    size_t      n = utf8_decode(utf8_text, len, cp);
+    size_t      inpos, outlen, i;
+    int         err;
+
+    outlen = convert(cs, "UTF-8", utf8_text, len, wide, sizeof(wide), &inpos, &err);
+    if (err || inpos != len || outlen != n * width)
+        FAIL("UTF-8 -> %s: err %d in %zu out %zu", cs, err, inpos, outlen);
+    for (i = 0; i < n && i * width < outlen; i++) {
+        uint32_t c = 0;
+        int b;
+        for (b = 0; b < width; b++) {
+            unsigned char byte = wide[i * width + (big ? b : width - 1 - b)];
+            c = (c << 8) | byte;
+        }
+        if (c != cp[i]) {
+            FAIL("UTF-8 -> %s: char %zu is %lx not %lx", cs, i,
+                 (unsigned long) c, (unsigned long) cp[i]);
+            break;
+        }
+    }
+
+    outlen = convert("UTF-8", cs, wide, n * width, back, sizeof(back), &inpos, &err);
+    if (err || inpos != n * width || outlen != len || memcmp(back, utf8_text, len) != 0)
+        FAIL("%s -> UTF-8: err %d in %zu out %zu", cs, err, inpos, outlen);
+}
+
+static void
+test_utf8_errors(void)
+{
+    static const struct {
+        const char      *in;
+        size_t          pos;
+    } bad[] = {
+        { "abcdefghijklmnop\xffqrstuvwxyz", 16 },
+        { "abcdefghijklmnop\xc0\x80qrstuvwxyz", 16 },
+        { "abcdefghijklmnop\xe0\x80\x80qrstuvwxyz", 16 },
+        { "abcdefghijklmnop\xed\xa0\x80qrstuvwxyz", 16 },
+        { "abcdefgh\xc3\xa9ijklmnop\x80qrstuvwxyz", 18 },
+    };
+    char        out[256];
+    size_t      i, inpos, outlen;
+    int         err;
+
+    for (i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        convert("UCS-4LE", "UTF-8", bad[i].in, strlen(bad[i].in),
+                out, sizeof(out), &inpos, &err);
+        if (err != EILSEQ || inpos != bad[i].pos)
+            FAIL("bad UTF-8 %zu: err %d in %zu", i, err, inpos);
+    }
+
+    /* a truncated sequence at the end is left for the next call */
+    outlen = convert("UCS-4LE", "UTF-8", "abcdefghijklmnop\xe2\x82", 18,
+                     out, sizeof(out), &inpos, &err);
+    if (err || inpos != 16 || outlen != 64)
+        FAIL("truncated UTF-8: err %d in %zu out %zu", err, inpos, outlen);
+}
+
+#ifdef __MB_EXTENDED_CHARSETS_ISO
+static void
+test_latin1(void)
+{
+    char        latin1[255 * 2];
+    char        utf8[255 * 4];
+    char        back[255 * 2];
+    size_t      i, inpos, outlen, len;
+    int         err;
+
+    for (i = 0; i < sizeof(latin1); i++)
+        latin1[i] = (char) (i % 255 + 1);
+
+    len = convert("UTF-8", "ISO-8859-1", latin1, sizeof(latin1), utf8, sizeof(utf8), &inpos, &err);
+    if (err || inpos != sizeof(latin1) || len != 2 * (127 + 128 * 2))
+        FAIL("ISO-8859-1 -> UTF-8: err %d in %zu out %zu", err, inpos, len);
+
+    outlen = convert("ISO-8859-1", "UTF-8", utf8, len, back, sizeof(back), &inpos, &err);
+    if (err || inpos != len || outlen != sizeof(latin1) || memcmp(back, latin1, outlen) != 0)
+        FAIL("UTF-8 -> ISO-8859-1: err %d in %zu out %zu", err, inpos, outlen);
+
+    /* U+20AC can't be represented; the input is consumed before that's noticed */
+    convert("ISO-8859-1", "UTF-8", "price: 100\xe2\x82\xac", 13, back, sizeof(back), &inpos, &err);
+    if (err != EILSEQ || inpos != 13)
+        FAIL("UTF-8 -> ISO-8859-1 euro: err %d in %zu", err, inpos);
+}
+#endif
+
+int main(void)
+{
+    test_utf8_errors();
+#ifdef __MB_EXTENDED_CHARSETS_UCS
+    test_round_trip("UCS-4LE", 4, 0, bmp_text);
+    test_round_trip("UCS-4BE", 4, 1, bmp_text);
+    test_round_trip("UCS-2LE", 2, 0, bmp_text);
+    test_round_trip("UCS-2BE", 2, 1, bmp_text);
+#if __SIZEOF_WCHAR_T__ > 2
+    test_round_trip("UCS-4LE", 4, 0, astral_text);
+    test_round_trip("UCS-4BE", 4, 1, astral_text);
+#endif
+#endif
+#ifdef __MB_EXTENDED_CHARSETS_ISO
+    test_latin1();
+#endif
+    if (failed) {
+        printf("%d failures\n", failed);
+        exit(1);
+    }
+    exit(0);
+}
+
+#else
+
+int main(void)
+{
+    exit(0);
+}
+
+#endif
@@ -54,6 +54,84 @@ extern char __tls_end[];
 #define __bss_size (__bss_end - __bss_start)
 #endif
 
+#ifdef __PICOCRT_COMPRESS_DATA
+/*
+ * Bounds of the compressed data image placed by picolibc-zdata.ld.
+ * picolibc.ld sets both to the same address. These are weak so that
+ * the compiler cannot assume they differ.
+ */
+extern const unsigned char __data_lz_source[] __weak;
+extern const unsigned char __data_lz_end[] __weak;
+
+/*
+ * The image covers ram from __data_start to __data_lz_ram_end. The
+ * rest, .tdata, stays uncompressed in flash at __tdata_lz_source as
+ * it is also the template for new TLS blocks.
+ */
+extern char __data_lz_ram_end[] __weak;
+extern const char __tdata_lz_source[] __weak;
+
+/*
+ * Expand the LZ4 block generated by picolibc-compress-data into
+ * the initialized data area. The block holds exactly the bytes from
+ * __data_start to __data_lz_ram_end, so decoding stops when that is
+ * full.
+ */
+static __always_inline void
+__data_lz_unpack(char *dst, char *end, const unsigned char *src)
+{
+        for (;;) {
+                unsigned token = *src++;
+                size_t len = token >> 4;
+                unsigned char c;
+
+                if (len == 15) {
+                        do {
+                                c = *src++;
+                                len += c;
+                        } while (c == 255);
+                }
+                while (len--)
+                        *dst++ = *src++;
+                if (dst >= end)
+                        break;
+
+                const char *match = dst - (src[0] | ((size_t) src[1] << 8));
+                src += 2;
+                len = token & 15;
+                if (len == 15) {
+                        do {
+                                c = *src++;
+                                len += c;
+                        } while (c == 255);
+                }
+                len += 4;
+                while (len--)
+                        *dst++ = *match++;
+        }
+}
+#endif
+
+/*
+ * Fill in the initialized data, .data and .tdata, starting at
+ * dst. crt0 passes __data_start.
+ */
+static __always_inline void
+__data_init(char *dst)
+{
+#ifdef __PICOCRT_COMPRESS_DATA
+        if (&__data_lz_end[0] != &__data_lz_source[0]) {
+                uintptr_t lz_size = (uintptr_t) (__data_lz_ram_end - __data_start);
+
+                __data_lz_unpack(dst, dst + lz_size, __data_lz_source);
+                memcpy(dst + lz_size, __tdata_lz_source,
+                       (uintptr_t) (__data_end - __data_lz_ram_end));
+                return;
+        }
+#endif
+	memcpy(dst, __data_source, (uintptr_t) __data_size);
+}
+
 /* These two functions must be defined in the architecture-specific
  * code
  */
@@ -91,7 +169,7 @@ extern void __libc_init_array(void);
 static __noreturn __always_inline void
 __start(void)
 {
-	memcpy(__data_start, __data_source, (uintptr_t) __data_size);
+	__data_init(__data_start);
 	memset(__bss_start, '\0', (uintptr_t) __bss_size);
 #ifdef POST_MEMORY_SETUP
         POST_MEMORY_SETUP();
@@ -37,9 +37,13 @@
 #include <sys/cdefs.h>
 #include <unistd.h>
 
+void __semihost_flush_console(void) __weak;
+
 __noreturn void
 _exit(int code)
 {
+	if (__semihost_flush_console)
+		__semihost_flush_console();
 	if (sys_semihost_feature(SH_EXT_EXIT_EXTENDED)) {
 		sys_semihost_exit_extended(code);
 	} else {
@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Buffered console. Output is collected in line buffers and handed
+ * to the host with a single SYS_WRITE instead of trapping once per
+ * character. Uses the ':tt' handles opened by _map_stdio.
+ */
+
+#include "semihost-private.h"
+#include <stdio-bufio.h>
+
+#ifndef SEMIHOST_BUFIO_SIZE
+#define SEMIHOST_BUFIO_SIZE     BUFSIZ
+#endif
+
+static ssize_t
+semihost_console_read(int fd, void *buf, size_t count)
+{
+        (void) fd;
+        if (count == 0)
+                return 0;
+        *(char *) buf = (char) sys_semihost_getc((FILE *) 0);
+        return 1;
+}
+
+static ssize_t
+semihost_console_write(int fd, const void *buf, size_t count)
+{
+        uintptr_t ret = sys_semihost_write(_map_stdio(fd), buf, count);
+
+        return (ssize_t) (count - ret);
+}
+
+static char read_buf[SEMIHOST_BUFIO_SIZE];
+static char write_buf[SEMIHOST_BUFIO_SIZE];
+static char error_buf[SEMIHOST_BUFIO_SIZE];
+
+#define SEMIHOST_CONSOLE(_fd, _buf, _rwflag, _bflags)                   \
+        FDEV_SETUP_BUFIO(_fd, _buf, SEMIHOST_BUFIO_SIZE,                \
+                         semihost_console_read, semihost_console_write, \
+                         NULL, NULL, _rwflag, _bflags)
+
+static struct __file_bufio __stdin = SEMIHOST_CONSOLE(0, read_buf, __SRD, 0);
+static struct __file_bufio __stdout = SEMIHOST_CONSOLE(1, write_buf, __SWR, __BLBF);
+static struct __file_bufio __stderr = SEMIHOST_CONSOLE(2, error_buf, __SWR, __BLBF);
+
+FILE *const stdin = &__stdin.xfile.cfile.file;
+FILE *const stdout = &__stdout.xfile.cfile.file;
+FILE *const stderr = &__stderr.xfile.cfile.file;
+
+/*
+ * Called from _exit so that output is not lost when the application
+ * leaves through abort() or _exit() without running destructors.
+ */
+void
+__semihost_flush_console(void)
+{
+        __bufio_flush(stderr);
+        __bufio_flush(stdout);
+}
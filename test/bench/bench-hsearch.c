@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+#include "bench.h"
+#include <search.h>
+#include <stdio.h>
+#include <string.h>
+
+#define NUM(a) (sizeof(a) / sizeof((a)[0]))
+#define NKEYS   1024
+#define KEYLEN  12
+
+/*
+ * Look up keys in an hsearch table, both when hcreate was given a
+ * good size estimate and when the estimate was far too small, which
+ * is where the chained and open-addressing tables differ the most.
+ * Compare the output with and without -Dhsearch-open-addressing=true.
+ * The tables are built once outside of the measured loops as the
+ * chained hdestroy_r doesn't free entries.
+ */
+
+static char keys[NKEYS][KEYLEN];
+static char misses[NKEYS][KEYLEN];
+
+struct hsearch_case {
+    struct hsearch_data htab;
+    char                (*lookup)[KEYLEN];
+    ACTION              action;
+};
+
+static void
+bench_hsearch(void *closure, unsigned long iters)
+{
+    struct hsearch_case *c = closure;
+    ENTRY item, *ent;
+    unsigned long i = 0;
+    uintptr_t found = 0;
+
+    item.data = NULL;
+    while (iters--) {
+        item.key = bench_hide(c->lookup[i]);
+        found += (uintptr_t) hsearch_r(item, c->action, &ent, &c->htab);
+        if (++i == NKEYS)
+            i = 0;
+    }
+    bench_consume(found);
+}
+
+static const size_t estimates[] = { 16, NKEYS };
+
+int
+main(void)
+{
+    static struct hsearch_case c;
+    char name[64];
+    ENTRY item, *ent;
+    size_t e;
+    int i;
+
+    for (i = 0; i < NKEYS; i++) {
+        snprintf(keys[i], KEYLEN, "key%d", i);
+        snprintf(misses[i], KEYLEN, "miss%d", i);
+    }
+
+    for (e = 0; e < NUM(estimates); e++) {
+        memset(&c.htab, 0, sizeof(c.htab));
+        if (!hcreate_r(estimates[e], &c.htab)) {
+            printf("hcreate_r failed\n");
+            return 1;
+        }
+        for (i = 0; i < NKEYS; i++) {
+            item.key = keys[i];
+            item.data = keys[i];
+            if (!hsearch_r(item, ENTER, &ent, &c.htab))
+                break;
+        }
+
+        /* Tables which don't grow (like glibc's) fill up */
+        if (i < NKEYS) {
+            printf("hsearch size %zu: table full after %d keys, skipped\n",
+                   estimates[e], i);
+            hdestroy_r(&c.htab);
+            continue;
+        }
+
+        c.lookup = keys;
+        c.action = FIND;
+        snprintf(name, sizeof(name), "hsearch find hit (size %zu)", estimates[e]);
+        bench_run(name, bench_hsearch, &c);
+
+        c.lookup = misses;
+        snprintf(name, sizeof(name), "hsearch find miss (size %zu)", estimates[e]);
+        bench_run(name, bench_hsearch, &c);
+
+        c.lookup = keys;
+        c.action = ENTER;
+        snprintf(name, sizeof(name), "hsearch enter existing (size %zu)", estimates[e]);
+        bench_run(name, bench_hsearch, &c);
+
+        hdestroy_r(&c.htab);
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdio.h>
+#include <string.h>
+#include <iconv.h>
+
+#define NUM(a) (sizeof(a) / sizeof((a)[0]))
+#define TEXT_LEN        1024
+
+/*
+ * Convert about 1kB of mostly-ASCII text between charsets. Each
+ * operation converts the whole block with a single iconv call.
+ */
+
+static char utf8[TEXT_LEN];
+static char latin1[TEXT_LEN];
+static char ucs2le[TEXT_LEN * 2];
+static char out[TEXT_LEN * 4 + 64];
+
+struct iconv_case {
+    const char  *from;
+    const char  *to;
+    char        *in;
+    size_t      len;
+};
+
+static struct iconv_case cases[] = {
+    { "UTF-8", "UCS-2LE", utf8, 0 },
+    { "UTF-8", "UCS-4", utf8, 0 },
+    { "UTF-8", "ISO-8859-1", utf8, 0 },
+    { "ISO-8859-1", "UTF-8", latin1, 0 },
+    { "UCS-2LE", "UTF-8", ucs2le, 0 },
+};
+
+static const char *const words[] = {
+    "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog",
+    "caf\xc3\xa9", "na\xc3\xafve", "\xc3\xa0", "r\xc3\xa9sum\xc3\xa9",
+};
+
+static void
+fill(void)
+{
+    uint32_t seed = 0x1c0de;
+    size_t n = 0, l = 0, u = 0;
+    const char *w;
+
+    while (n < TEXT_LEN - 16) {
+        w = words[bench_random(&seed) % NUM(words)];
+        n += snprintf(utf8 + n, TEXT_LEN - n, "%s ", w);
+    }
+    /* every word fits in Latin-1, which makes the other encodings easy */
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = utf8[i];
+        if (c >= 0x80)
+            c = ((c & 0x1f) << 6) | (utf8[++i] & 0x3f);
+        latin1[l++] = c;
+        ucs2le[u++] = c;
+        ucs2le[u++] = 0;
+    }
+    cases[0].len = cases[1].len = cases[2].len = n;
+    cases[3].len = l;
+    cases[4].len = u;
+}
+
+struct iconv_closure {
+    iconv_t             ic;
+    struct iconv_case   *c;
+};
+
+static void
+bench_iconv(void *closure, unsigned long iters)
+{
+    struct iconv_closure *ic = closure;
+    size_t total = 0;
+
+    while (iters--) {
+        char *in = bench_hide(ic->c->in);
+        char *o = out;
+        size_t inbytes = ic->c->len;
+        size_t outbytes = sizeof(out);
+
+        iconv(ic->ic, &in, &inbytes, &o, &outbytes);
+        total += o - out;
+    }
+    bench_consume(total);
+}
+
+int
+main(void)
+{
+    struct iconv_closure ic;
+    char name[64];
+    size_t c;
+
+    fill();
+    for (c = 0; c < NUM(cases); c++) {
+        ic.c = &cases[c];
+        ic.ic = iconv_open(cases[c].to, cases[c].from);
+        if (ic.ic == (iconv_t) -1) {
+            printf("iconv %s -> %s not supported\n", cases[c].from, cases[c].to);
+            continue;
+        }
+        snprintf(name, sizeof(name), "iconv %s -> %s", cases[c].from, cases[c].to);
+        bench_run(name, bench_iconv, &ic);
+        iconv_close(ic.ic);
+    }
+    return 0;
+}
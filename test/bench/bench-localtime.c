@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define NUM(a) (sizeof(a) / sizeof((a)[0]))
+#define NTIMES  256
+
+/*
+ * Convert batches of timestamps to local time. The 'mixed' batches
+ * hop between three years, as happens when replaying logs which span
+ * New Year, which used to recompute the DST change-over times on
+ * every call.
+ */
+
+static time_t times[NTIMES];
+static struct tm tms[NTIMES];
+
+static void
+fill(time_t base, time_t span)
+{
+    uint32_t seed = 0x7173;
+    size_t i;
+
+    for (i = 0; i < NTIMES; i++)
+        times[i] = base + (time_t) (bench_random(&seed) % (uint32_t) span);
+    for (i = 0; i < NTIMES; i++)
+        localtime_r(&times[i], &tms[i]);
+}
+
+static void
+bench_localtime(void *closure, unsigned long iters)
+{
+    struct tm tm;
+    uintptr_t total = 0;
+    (void) closure;
+
+    while (iters--) {
+        const time_t *t = bench_hide(&times[iters % NTIMES]);
+        localtime_r(t, &tm);
+        total += tm.tm_hour;
+    }
+    bench_consume(total);
+}
+
+static void
+bench_mktime(void *closure, unsigned long iters)
+{
+    struct tm tm;
+    uintptr_t total = 0;
+    (void) closure;
+
+    while (iters--) {
+        tm = tms[iters % NTIMES];
+        tm.tm_isdst = -1;
+        total += (uintptr_t) mktime(bench_hide(&tm));
+    }
+    bench_consume(total);
+}
+
+/* 2023-12-31 00:00:00 UTC */
+#define NEW_YEAR_2024   ((time_t) 1703980800)
+#define DAY             ((time_t) 86400)
+#define YEAR            ((time_t) 365 * DAY)
+
+int
+main(void)
+{
+    setenv("TZ", "PST8PDT,M3.2.0,M11.1.0", 1);
+
+    fill(NEW_YEAR_2024 + 200 * DAY, 30 * DAY);
+    bench_run("localtime_r one year", bench_localtime, NULL);
+    bench_run("mktime one year", bench_mktime, NULL);
+
+    fill(NEW_YEAR_2024 - YEAR / 2, 2 * YEAR);
+    bench_run("localtime_r mixed years", bench_localtime, NULL);
+    bench_run("mktime mixed years", bench_mktime, NULL);
+    return 0;
+}
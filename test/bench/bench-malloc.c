@@ -0,0 +1,170 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM(a) (sizeof(a) / sizeof((a)[0]))
+#define SLOTS   256
+
+static void *slots[SLOTS];
+
+static void
+release_slots(void)
+{
+    size_t i;
+
+    for (i = 0; i < SLOTS; i++) {
+        free(slots[i]);
+        slots[i] = NULL;
+    }
+}
+
+/* Allocate and immediately free a block of one size */
+static void
+bench_pair(void *closure, unsigned long iters)
+{
+    size_t size = *(size_t *) closure;
+
+    while (iters--) {
+        void *p = malloc(size);
+        bench_consume((uintptr_t) bench_hide(p));
+        free(p);
+    }
+}
+
+/* Replace blocks in allocation order so the oldest is always freed */
+static void
+bench_fifo(void *closure, unsigned long iters)
+{
+    size_t max = *(size_t *) closure;
+    uint32_t seed = 0x12345678;
+    size_t i = 0;
+
+    while (iters--) {
+        free(slots[i]);
+        slots[i] = malloc(bench_random(&seed) % max + 1);
+        i = (i + 1) % SLOTS;
+    }
+    release_slots();
+}
+
+/* Push and pop blocks like a stack whose depth wanders at random */
+static void
+bench_lifo(void *closure, unsigned long iters)
+{
+    size_t max = *(size_t *) closure;
+    uint32_t seed = 0x9abcdef0;
+    size_t depth = 0;
+
+    while (iters--) {
+        uint32_t r = bench_random(&seed);
+        if (depth == SLOTS || (depth > 0 && (r & 1))) {
+            free(slots[--depth]);
+            slots[depth] = NULL;
+        } else {
+            slots[depth++] = malloc((r >> 1) % max + 1);
+        }
+    }
+    release_slots();
+}
+
+/* Replace randomly chosen blocks, fragmenting the heap */
+static void
+bench_random_churn(void *closure, unsigned long iters)
+{
+    size_t max = *(size_t *) closure;
+    uint32_t seed = 0x0badcafe;
+
+    while (iters--) {
+        uint32_t r = bench_random(&seed);
+        size_t i = r % SLOTS;
+        free(slots[i]);
+        slots[i] = malloc((r >> 8) % max + 1);
+    }
+    release_slots();
+}
+
+/* Grow a block a little at a time, the way a string builder does */
+static void
+bench_realloc(void *closure, unsigned long iters)
+{
+    size_t step = *(size_t *) closure;
+    size_t size = 0;
+    void *p = NULL;
+
+    while (iters--) {
+        size += step;
+        if (size > 8192) {
+            free(p);
+            p = NULL;
+            size = step;
+        }
+        p = realloc(p, size);
+    }
+    bench_consume((uintptr_t) p);
+    free(p);
+}
+
+static const struct {
+    const char      *name;
+    bench_func_t    func;
+    size_t          arg;
+} cases[] = {
+    { "malloc/free 16",         bench_pair,         16 },
+    { "malloc/free 256",        bench_pair,         256 },
+    { "malloc/free 4096",       bench_pair,         4096 },
+    { "fifo churn <= 64",       bench_fifo,         64 },
+    { "fifo churn <= 1024",     bench_fifo,         1024 },
+    { "lifo churn <= 64",       bench_lifo,         64 },
+    { "lifo churn <= 1024",     bench_lifo,         1024 },
+    { "random churn <= 64",     bench_random_churn, 64 },
+    { "random churn <= 1024",   bench_random_churn, 1024 },
+    { "realloc grow by 16",     bench_realloc,      16 },
+    { "realloc grow by 256",    bench_realloc,      256 },
+};
+
+int
+main(void)
+{
+    size_t i;
+
+    for (i = 0; i < NUM(cases); i++) {
+        size_t arg = cases[i].arg;
+        bench_run(cases[i].name, cases[i].func, &arg);
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdio.h>
+#include <math.h>
+
+#define NUM(a) (sizeof(a) / sizeof((a)[0]))
+#define NINPUT  64
+
+struct math_case {
+    const char  *name;
+    double      (*func)(double);
+    double      (*func2)(double, double);
+    float       (*funcf)(float);
+    float       (*func2f)(float, float);
+    double      lo, hi;
+};
+
+static double input[NINPUT];
+static double input2[NINPUT];
+static float inputf[NINPUT];
+static float input2f[NINPUT];
+
+/* Spread the inputs evenly over [lo, hi] in a scrambled order */
+static void
+fill(const struct math_case *c)
+{
+    size_t i;
+
+    for (i = 0; i < NINPUT; i++) {
+        size_t j = (i * 37) % NINPUT;
+        input[j] = c->lo + (c->hi - c->lo) * (double) i / (NINPUT - 1);
+        input2[(j + 11) % NINPUT] = c->lo + (c->hi - c->lo) * (double) (NINPUT - 1 - i) / (NINPUT - 1);
+        inputf[j] = (float) input[j];
+        input2f[j] = (float) input2[j];
+    }
+}
+
+static void
+bench_math(void *closure, unsigned long iters)
+{
+    const struct math_case *c = closure;
+    double (*func)(double) = c->func;
+    double total = 0;
+    size_t i = 0;
+
+    while (iters--) {
+        total += func(input[i]);
+        i = (i + 1) % NINPUT;
+    }
+    bench_consume_float(total);
+}
+
+static void
+bench_math2(void *closure, unsigned long iters)
+{
+    const struct math_case *c = closure;
+    double (*func2)(double, double) = c->func2;
+    double total = 0;
+    size_t i = 0;
+
+    while (iters--) {
+        total += func2(input[i], input2[i]);
+        i = (i + 1) % NINPUT;
+    }
+    bench_consume_float(total);
+}
+
+static void
+bench_mathf(void *closure, unsigned long iters)
+{
+    const struct math_case *c = closure;
+    float (*funcf)(float) = c->funcf;
+    float total = 0;
+    size_t i = 0;
+
+    while (iters--) {
+        total += funcf(inputf[i]);
+        i = (i + 1) % NINPUT;
+    }
+    bench_consume_float(total);
+}
+
+static void
+bench_math2f(void *closure, unsigned long iters)
+{
+    const struct math_case *c = closure;
+    float (*func2f)(float, float) = c->func2f;
+    float total = 0;
+    size_t i = 0;
+
+    while (iters--) {
+        total += func2f(inputf[i], input2f[i]);
+        i = (i + 1) % NINPUT;
+    }
+    bench_consume_float(total);
+}
+
+#define CASE1(fn, lo, hi)       { #fn, fn, NULL, fn ## f, NULL, lo, hi }
+#define CASE2(fn, lo, hi)       { #fn, NULL, fn, NULL, fn ## f, lo, hi }
+
+static const struct math_case cases[] = {
+    CASE1(sqrt,     0.0,    1e6),
+    CASE1(sin,      -10.0,  10.0),
+    CASE1(cos,      -10.0,  10.0),
+    CASE1(tan,      -1.5,   1.5),
+    CASE1(asin,     -1.0,   1.0),
+    CASE1(atan,     -100.0, 100.0),
+    CASE1(exp,      -80.0,  80.0),
+    CASE1(exp2,     -100.0, 100.0),
+    CASE1(log,      1e-5,   1e5),
+    CASE1(log2,     1e-5,   1e5),
+    CASE1(log10,    1e-5,   1e5),
+    CASE1(sinh,     -10.0,  10.0),
+    CASE1(tanh,     -10.0,  10.0),
+    CASE1(cbrt,     -1e6,   1e6),
+    CASE1(floor,    -1e6,   1e6),
+    CASE2(pow,      0.5,    30.0),
+    CASE2(atan2,    -10.0,  10.0),
+    CASE2(hypot,    -1e3,   1e3),
+    CASE2(fmod,     1.0,    1e4),
+};
+
+int
+main(void)
+{
+    char name[64];
+    size_t i;
+
+    for (i = 0; i < NUM(cases); i++) {
+        const struct math_case *c = &cases[i];
+
+        fill(c);
+        if (c->func) {
+            bench_run(c->name, bench_math, (void *) c);
+            snprintf(name, sizeof(name), "%sf", c->name);
+            bench_run(name, bench_mathf, (void *) c);
+        } else {
+            bench_run(c->name, bench_math2, (void *) c);
+            snprintf(name, sizeof(name), "%sf", c->name);
+            bench_run(name, bench_math2f, (void *) c);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM(a) (sizeof(a) / sizeof((a)[0]))
+#define MAX_ELEMENTS    1000
+
+enum pattern { RANDOM, SORTED, REVERSED, FEW_VALUES };
+
+static const char *const pattern_names[] = {
+    [RANDOM] = "random",
+    [SORTED] = "sorted",
+    [REVERSED] = "reversed",
+    [FEW_VALUES] = "few values",
+};
+
+struct qsort_case {
+    enum pattern    pattern;
+    size_t          n;
+};
+
+static int input[MAX_ELEMENTS];
+static int work[MAX_ELEMENTS];
+
+static int
+cmp_int(const void *a, const void *b)
+{
+    int x = *(const int *) a;
+    int y = *(const int *) b;
+
+    return (x > y) - (x < y);
+}
+
+static void
+fill(struct qsort_case *c)
+{
+    uint32_t seed = 0xfeedf00d;
+    size_t i;
+
+    for (i = 0; i < c->n; i++) {
+        switch (c->pattern) {
+        case RANDOM:
+            input[i] = (int) (bench_random(&seed) >> 1);
+            break;
+        case SORTED:
+            input[i] = (int) i;
+            break;
+        case REVERSED:
+            input[i] = (int) (c->n - i);
+            break;
+        case FEW_VALUES:
+            input[i] = (int) (bench_random(&seed) % 8);
+            break;
+        }
+    }
+}
+
+/* Each operation is a complete sort of a fresh copy of the input */
+static void
+bench_qsort(void *closure, unsigned long iters)
+{
+    struct qsort_case *c = closure;
+
+    while (iters--) {
+        memcpy(work, input, c->n * sizeof(int));
+        qsort(bench_hide(work), c->n, sizeof(int), cmp_int);
+    }
+    bench_consume((uintptr_t) work[0]);
+}
+
+static const size_t sizes[] = { 10, 100, MAX_ELEMENTS };
+
+int
+main(void)
+{
+    struct qsort_case c;
+    char name[64];
+    size_t s, p;
+
+    for (p = 0; p < NUM(pattern_names); p++) {
+        for (s = 0; s < NUM(sizes); s++) {
+            c.pattern = (enum pattern) p;
+            c.n = sizes[s];
+            fill(&c);
+            snprintf(name, sizeof(name), "qsort %s %zu", pattern_names[p], c.n);
+            bench_run(name, bench_qsort, &c);
+        }
+    }
+    return 0;
+}
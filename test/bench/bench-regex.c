@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdio.h>
+#include <string.h>
+#include <regex.h>
+
+#define NUM(a) (sizeof(a) / sizeof((a)[0]))
+#define NLINES  256
+#define LINE_LEN 120
+
+/*
+ * Filter syslog-style lines through a regex, the way a log scanner
+ * would. Matches are rare: only one line in NLINES contains text
+ * matching each pattern, so the cost is dominated by rejecting lines.
+ */
+
+static char lines[NLINES][LINE_LEN];
+
+static const char *const words[] = {
+    "connection", "from", "port", "session", "opened", "closed", "user",
+    "accepted", "publickey", "for", "received", "disconnect", "by",
+    "pam_unix", "reset", "peer", "invalid", "request", "sent", "bytes",
+};
+
+static const char *const rare[] = {
+    "kernel: segfault at 0 ip",
+    "ERROR disk 97% full on /var",
+    "upstream timeout after 3000 ms",
+};
+
+struct regex_case {
+    const char  *pattern;
+    int         cflags;
+};
+
+static const struct regex_case cases[] = {
+    { "segfault", REG_EXTENDED | REG_NOSUB },
+    { "^ERROR", REG_EXTENDED | REG_NOSUB },
+    { "disk [0-9]+% full", REG_EXTENDED | REG_NOSUB },
+    { "timeout|refused", REG_EXTENDED | REG_NOSUB },
+    { "[0-9]+ ms$", REG_EXTENDED | REG_NOSUB },
+    { "user=([a-z]+) .*denied", REG_EXTENDED },
+};
+
+static void
+fill(void)
+{
+    uint32_t seed = 0x5eed1234;
+    size_t i;
+
+    for (i = 0; i < NLINES; i++) {
+        char *l = lines[i];
+        int n;
+
+        n = snprintf(l, LINE_LEN, "Oct 17 12:%02u:%02u host%u sshd[%u]:",
+                     (unsigned) (i / 60 % 60), (unsigned) (i % 60),
+                     (unsigned) (i % 7), (unsigned) (1000 + i));
+        if (i % (NLINES / NUM(rare)) == 1) {
+            snprintf(l + n, LINE_LEN - n, " %s", rare[i / (NLINES / NUM(rare)) % NUM(rare)]);
+            continue;
+        }
+        while (n < LINE_LEN - 16)
+            n += snprintf(l + n, LINE_LEN - n, " %s",
+                          words[bench_random(&seed) % NUM(words)]);
+    }
+}
+
+/* Each operation runs regexec over one line */
+static void
+bench_regexec(void *closure, unsigned long iters)
+{
+    regex_t *re = closure;
+    regmatch_t match[2];
+    unsigned long hits = 0;
+    size_t i = 0;
+
+    while (iters--) {
+        hits += regexec(re, bench_hide(lines[i]), 2, match, 0) == 0;
+        i = (i + 1) % NLINES;
+    }
+    bench_consume(hits);
+}
+
+int
+main(void)
+{
+    regex_t re;
+    char name[64];
+    size_t c;
+
+    fill();
+    for (c = 0; c < NUM(cases); c++) {
+        if (regcomp(&re, cases[c].pattern, cases[c].cflags) != 0) {
+            printf("regcomp \"%s\" failed\n", cases[c].pattern);
+            return 1;
+        }
+        snprintf(name, sizeof(name), "regexec \"%s\"", cases[c].pattern);
+        bench_run(name, bench_regexec, &re);
+        regfree(&re);
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdio.h>
+
+#define NUM(a) (sizeof(a) / sizeof((a)[0]))
+
+static char out[256];
+
+static void
+bench_int(void *closure, unsigned long iters)
+{
+    int v = 0;
+
+    (void) closure;
+    while (iters--)
+        snprintf(out, sizeof(out), "%d", v++ * 7919);
+    bench_consume((uintptr_t) out[0]);
+}
+
+static void
+bench_mixed(void *closure, unsigned long iters)
+{
+    unsigned v = 0;
+
+    (void) closure;
+    while (iters--) {
+        snprintf(out, sizeof(out), "%s:%-8u %#x %c %ld", "key", v, v * 31u, 'a' + (v & 15), -(long) v);
+        v++;
+    }
+    bench_consume((uintptr_t) out[0]);
+}
+
+static void
+bench_float(void *closure, unsigned long iters)
+{
+    double d = 1.0 / 3.0;
+
+    (void) closure;
+    while (iters--) {
+        snprintf(out, sizeof(out), "%g %.3f %e", d, d * 1000, d * 1e-20);
+        d += 1.25;
+    }
+    bench_consume((uintptr_t) out[0]);
+}
+
+static void
+bench_scan_int(void *closure, unsigned long iters)
+{
+    int a, b, c;
+    unsigned total = 0;
+
+    (void) closure;
+    while (iters--) {
+        sscanf(bench_hide("12345 -678 0x7fff"), "%d %d %i", &a, &b, &c);
+        total += a + b + c;
+    }
+    bench_consume((uintptr_t) total);
+}
+
+static void
+bench_scan_mixed(void *closure, unsigned long iters)
+{
+    char word[32];
+    unsigned x;
+    char ch;
+    unsigned total = 0;
+
+    (void) closure;
+    while (iters--) {
+        sscanf(bench_hide("keyword: deadbeef z"), "%31[^:]: %x %c", word, &x, &ch);
+        total += x + (unsigned) ch + (unsigned) word[0];
+    }
+    bench_consume((uintptr_t) total);
+}
+
+static void
+bench_scan_float(void *closure, unsigned long iters)
+{
+    double a, b;
+    double total = 0;
+
+    (void) closure;
+    while (iters--) {
+        sscanf(bench_hide("3.14159265358979 -2.5e-17"), "%lf %lf", &a, &b);
+        total += a + b;
+    }
+    bench_consume_float(total);
+}
+
+static const struct {
+    const char      *name;
+    bench_func_t    func;
+} cases[] = {
+    { "printf %d",              bench_int },
+    { "printf %s %u %x %c %ld", bench_mixed },
+    { "printf %g %f %e",        bench_float },
+    { "scanf %d %d %i",         bench_scan_int },
+    { "scanf %[ %x %c",         bench_scan_mixed },
+    { "scanf %lf %lf",          bench_scan_float },
+};
+
+int
+main(void)
+{
+    size_t i;
+
+    for (i = 0; i < NUM(cases); i++)
+        bench_run(cases[i].name, cases[i].func, NULL);
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_LEN 4096
+
+static char src_buf[MAX_LEN + 64];
+static char dst_buf[MAX_LEN + 64];
+static char cmp_buf[MAX_LEN + 64];
+
+struct string_case {
+    size_t      len;
+    size_t      src_align;
+    size_t      dst_align;
+};
+
+static void
+bench_memcpy(void *closure, unsigned long iters)
+{
+    struct string_case *c = closure;
+    char *dst = dst_buf + c->dst_align;
+    const char *src = src_buf + c->src_align;
+
+    while (iters--) {
+        memcpy(bench_hide(dst), src, c->len);
+    }
+    bench_consume((uintptr_t) dst[0]);
+}
+
+static void
+bench_strlen(void *closure, unsigned long iters)
+{
+    struct string_case *c = closure;
+    const char *s = src_buf + c->src_align;
+    size_t total = 0;
+
+    while (iters--)
+        total += strlen(bench_hide(s));
+    bench_consume(total);
+}
+
+static void
+bench_strcmp(void *closure, unsigned long iters)
+{
+    struct string_case *c = closure;
+    const char *a = src_buf + c->src_align;
+    const char *b = cmp_buf + c->dst_align;
+    unsigned total = 0;
+
+    while (iters--)
+        total += (unsigned) strcmp(bench_hide(a), b);
+    bench_consume((uintptr_t) total);
+}
+
+static const size_t lengths[] = { 1, 8, 32, 128, 512, 4096 };
+
+static const size_t alignments[][2] = {
+    { 0, 0 },
+    { 1, 0 },
+    { 3, 5 },
+};
+
+#define NUM(a) (sizeof(a) / sizeof((a)[0]))
+
+/* Fill the source with a NUL at 'len' and the comparison buffer to match */
+static void
+setup(struct string_case *c)
+{
+    memset(src_buf, 'a', sizeof(src_buf));
+    memset(cmp_buf, 'a', sizeof(cmp_buf));
+    src_buf[c->src_align + c->len] = '\0';
+    cmp_buf[c->dst_align + c->len] = '\0';
+}
+
+int
+main(void)
+{
+    struct string_case c;
+    char name[64];
+    size_t l, a;
+
+    for (l = 0; l < NUM(lengths); l++) {
+        for (a = 0; a < NUM(alignments); a++) {
+            c.len = lengths[l];
+            c.src_align = alignments[a][0];
+            c.dst_align = alignments[a][1];
+            setup(&c);
+
+            snprintf(name, sizeof(name), "memcpy %zu/%zu/%zu", c.len, c.src_align, c.dst_align);
+            bench_run(name, bench_memcpy, &c);
+
+            snprintf(name, sizeof(name), "strlen %zu/%zu", c.len, c.src_align);
+            bench_run(name, bench_strlen, &c);
+
+            snprintf(name, sizeof(name), "strcmp %zu/%zu/%zu", c.len, c.src_align, c.dst_align);
+            bench_run(name, bench_strcmp, &c);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM(a) (sizeof(a) / sizeof((a)[0]))
+
+static const char *const short_strings[] = {
+    "0", "1", "2.5", "-17", "100", "0.125", "3e5", "42.0",
+};
+
+static const char *const long_strings[] = {
+    "3.141592653589793",
+    "2.718281828459045",
+    "-1.7976931348623157e308",
+    "2.2250738585072014e-308",
+    "4.9406564584124654e-324",
+    "123456789012345678901234567890",
+    "0.000000000000000000000123456789",
+    "1.00000000000000011102230246251565404236316680908203125",
+};
+
+struct strtod_case {
+    const char *const   *strings;
+    size_t              count;
+};
+
+static void
+bench_strtod(void *closure, unsigned long iters)
+{
+    struct strtod_case *c = closure;
+    double total = 0;
+    size_t i = 0;
+
+    while (iters--) {
+        total += strtod(bench_hide(c->strings[i]), NULL);
+        if (++i == c->count)
+            i = 0;
+    }
+    bench_consume_float(total);
+}
+
+static void
+bench_strtof(void *closure, unsigned long iters)
+{
+    struct strtod_case *c = closure;
+    float total = 0;
+    size_t i = 0;
+
+    while (iters--) {
+        total += strtof(bench_hide(c->strings[i]), NULL);
+        if (++i == c->count)
+            i = 0;
+    }
+    bench_consume_float(total);
+}
+
+#if __SIZEOF_DOUBLE__ == 8
+/* Doubles from all over the exponent range, where the power-of-five
+ * multipliers differ from call to call */
+static void
+bench_print_wide(void *closure, unsigned long iters)
+{
+    const char *fmt = closure;
+    uint32_t seed = 0x1234567;
+    char buf[64];
+    int len = 0;
+
+    while (iters--) {
+        union { uint64_t u; double d; } v;
+        v.u = ((uint64_t) bench_random(&seed) << 32) | bench_random(&seed);
+        if ((v.u >> 52 & 0x7ff) == 0x7ff)
+            v.u ^= 1ULL << 62;
+        len += snprintf(buf, sizeof(buf), fmt, v.d);
+    }
+    bench_consume(len);
+}
+
+/* Print with enough digits to be exact and read the value back */
+static void
+bench_round_trip(void *closure, unsigned long iters)
+{
+    const char *fmt = closure;
+    uint32_t seed = 0x2468ace0;
+    char buf[64];
+    unsigned long errors = 0;
+
+    while (iters--) {
+        union { uint64_t u; double d; } v;
+        v.u = ((uint64_t) bench_random(&seed) << 32) | bench_random(&seed);
+        /* Keep the exponent in the normal range */
+        v.u = (v.u & 0x800fffffffffffffULL) | ((uint64_t) (0x300 + (v.u >> 52 & 0x1ff)) << 52);
+        snprintf(buf, sizeof(buf), fmt, v.d);
+        if (strtod(buf, NULL) != v.d)
+            errors++;
+    }
+    if (errors)
+        printf("%s: %lu round trip errors\n", fmt, errors);
+    bench_consume(errors);
+}
+#endif
+
+/* Shortest representation, as produced by the ryu engine */
+static void
+bench_shortest(void *closure, unsigned long iters)
+{
+    uint32_t seed = 0x13579bdf;
+    char buf[64];
+
+    (void) closure;
+    while (iters--) {
+        double d = (double) bench_random(&seed) / 65536.0;
+        snprintf(buf, sizeof(buf), "%g", d);
+    }
+    bench_consume((uintptr_t) buf[0]);
+}
+
+int
+main(void)
+{
+    struct strtod_case short_case = { short_strings, NUM(short_strings) };
+    struct strtod_case long_case = { long_strings, NUM(long_strings) };
+
+    bench_run("strtod short", bench_strtod, &short_case);
+    bench_run("strtod long", bench_strtod, &long_case);
+    bench_run("strtof short", bench_strtof, &short_case);
+    bench_run("strtof long", bench_strtof, &long_case);
+#if __SIZEOF_DOUBLE__ == 8
+    bench_run("round trip %.17g", bench_round_trip, (void *) "%.17g");
+    bench_run("round trip %a", bench_round_trip, (void *) "%a");
+    bench_run("printf %.17g wide", bench_print_wide, (void *) "%.17g");
+    bench_run("printf %g wide", bench_print_wide, (void *) "%g");
+#endif
+    bench_run("printf %g", bench_shortest, NULL);
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include "../../picocrt/crt0.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* crt0.h leaves these defined after __start */
+#undef argc
+#undef argv
+
+/*
+ * Time the initialized data setup done by picocrt at startup. This
+ * is linked with picolibc.ld, where it copies .data from flash, and
+ * with picolibc-zdata.ld, where it expands the compressed image. The
+ * data is written to a scratch buffer so the running program is left
+ * alone.
+ */
+
+#define SQ(i)           ((i) * (i))
+#define SQ4(i)          SQ(i), SQ(i+1), SQ(i+2), SQ(i+3)
+#define SQ16(i)         SQ4(i), SQ4(i+4), SQ4(i+8), SQ4(i+12)
+#define SQ64(i)         SQ16(i), SQ16(i+16), SQ16(i+32), SQ16(i+48)
+
+unsigned squares[256] = { SQ64(0), SQ64(64), SQ64(128), SQ64(192) };
+
+int sparse[1024] = { [0] = 1, [1] = 2, [100] = 3, [1000] = 4, [1023] = 5 };
+
+char message[] = "The quick brown fox jumps over the lazy dog";
+
+static void
+bench_data_init(void *closure, unsigned long iters)
+{
+    char *scratch = closure;
+
+    while (iters--)
+        __data_init(bench_hide(scratch));
+    bench_consume((uintptr_t) scratch[0]);
+}
+
+int
+main(int argc, char **argv)
+{
+    size_t size = (size_t) (__data_end - __data_start);
+    char *scratch = malloc(size ? size : 1);
+    bool compressed = false;
+
+    (void) argc;
+    (void) argv;
+    if (!scratch)
+        return 1;
+#ifdef __PICOCRT_COMPRESS_DATA
+    compressed = &__data_lz_end[0] != &__data_lz_source[0];
+    if (compressed)
+        printf("data %zu bytes, compressed image %zu bytes\n",
+               size, (size_t) (__data_lz_end - __data_lz_source));
+    else
+#endif
+        printf("data %zu bytes\n", size);
+    bench_run(compressed ? "data init compressed" : "data init copy",
+              bench_data_init, scratch);
+    free(scratch);
+    return 0;
+}
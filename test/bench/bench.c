@@ -0,0 +1,175 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _DEFAULT_SOURCE
+#include "bench.h"
+#include <stdio.h>
+#include <time.h>
+#ifdef BENCH_SEMIHOST
+#include <semihost.h>
+#endif
+#ifndef BENCH_NATIVE
+#include <picolibc/bench.h>
+#endif
+
+#define NSEC_PER_SEC    1000000000ULL
+
+/* Never time less than this, however fine the clock */
+#define BENCH_MIN_NS    (20ULL * 1000 * 1000)
+
+/* Nor more than this, however coarse */
+#define BENCH_MAX_NS    (2ULL * NSEC_PER_SEC)
+
+/* Measurements should span this many clock ticks */
+#define BENCH_TICKS     100
+
+volatile uintptr_t bench_sink;
+volatile double bench_sink_float;
+
+#ifndef BENCH_NATIVE
+static uint64_t
+ticks_to_ns(uint64_t ticks, uint64_t freq)
+{
+    return (ticks / freq) * NSEC_PER_SEC + (ticks % freq) * NSEC_PER_SEC / freq;
+}
+#endif
+
+#ifdef BENCH_SEMIHOST
+
+/*
+ * SYS_ELAPSED and SYS_TICKFREQ are not implemented by every
+ * semihosting host (qemu lacks them); fall back to the centisecond
+ * SYS_CLOCK when they are unavailable.
+ */
+static uintptr_t tickfreq;
+
+uint64_t
+bench_now_ns(void)
+{
+    if (!tickfreq) {
+        tickfreq = sys_semihost_tickfreq();
+        if (tickfreq == 0 || tickfreq == (uintptr_t) -1 || sys_semihost_elapsed() == 0)
+            tickfreq = (uintptr_t) -1;
+    }
+    if (tickfreq != (uintptr_t) -1)
+        return ticks_to_ns(sys_semihost_elapsed(), tickfreq);
+    return ticks_to_ns(sys_semihost_clock(), 100);
+}
+
+#elif defined(BENCH_NATIVE)
+
+uint64_t
+bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+#else
+
+uint64_t
+bench_now_ns(void)
+{
+    return ticks_to_ns(clock(), CLOCKS_PER_SEC);
+}
+
+#endif
+
+/* Wait for the clock to tick twice to learn its resolution */
+static uint64_t
+bench_resolution(void)
+{
+    static uint64_t resolution;
+    uint64_t t0, t1, t2;
+
+    if (resolution)
+        return resolution;
+    t0 = bench_now_ns();
+    while ((t1 = bench_now_ns()) == t0)
+        ;
+    while ((t2 = bench_now_ns()) == t1)
+        ;
+    resolution = t2 - t1;
+    return resolution;
+}
+
+void
+bench_run(const char *name, bench_func_t func, void *closure)
+{
+    uint64_t target = bench_resolution() * BENCH_TICKS;
+    unsigned long iters = 1;
+    uint64_t start, elapsed, next;
+#ifdef PICOLIBC_BENCH_COUNTER
+    struct bench_timer timer;
+#endif
+
+    if (target < BENCH_MIN_NS)
+        target = BENCH_MIN_NS;
+    if (target > BENCH_MAX_NS)
+        target = BENCH_MAX_NS;
+
+    /* Warm caches and any lazily initialized state */
+    func(closure, 1);
+
+    for (;;) {
+        start = bench_now_ns();
+#ifdef PICOLIBC_BENCH_COUNTER
+        bench_start(&timer);
+#endif
+        func(closure, iters);
+#ifdef PICOLIBC_BENCH_COUNTER
+        bench_stop(&timer);
+#endif
+        elapsed = bench_now_ns() - start;
+        if (elapsed >= target || iters >= (1UL << 30))
+            break;
+        /* Scale towards the target, at most 16x per step */
+        if (elapsed < target / 16)
+            next = (uint64_t) iters * 16;
+        else
+            next = (uint64_t) iters * target / elapsed + 1;
+        if (next > (1UL << 30))
+            next = 1UL << 30;
+        iters = (unsigned long) next;
+    }
+#ifdef PICOLIBC_BENCH_COUNTER
+    printf("%-32s %12.2f ns/op %12.2f cycles/op\n", name, (double) elapsed / (double) iters,
+           (double) bench_elapsed(&timer) / (double) iters);
+#else
+    printf("%-32s %12.2f ns/op\n", name, (double) elapsed / (double) iters);
+#endif
+}
@@ -0,0 +1,96 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Minimal benchmark harness shared by the programs in this
+ * directory. Each benchmark supplies a function which performs the
+ * operation 'iters' times; bench_run repeats it with growing
+ * iteration counts until the run takes long enough to be measured
+ * with the available clock, then prints the cost in ns/op.
+ */
+
+typedef void (*bench_func_t)(void *closure, unsigned long iters);
+
+void
+bench_run(const char *name, bench_func_t func, void *closure);
+
+/* Current time in nanoseconds from the best clock available */
+uint64_t
+bench_now_ns(void);
+
+/* Stores here keep the compiler from discarding benchmark results */
+extern volatile uintptr_t bench_sink;
+extern volatile double bench_sink_float;
+
+static inline void
+bench_consume(uintptr_t v)
+{
+    bench_sink = v;
+}
+
+static inline void
+bench_consume_float(double v)
+{
+    bench_sink_float = v;
+}
+
+/* Hide a pointer from the optimizer so repeated calls are not folded */
+static inline void *
+bench_hide(const void *p)
+{
+    void *r = (void *) p;
+    __asm__ volatile ("" : "+r" (r) : : "memory");
+    return r;
+}
+
+/* Deterministic generator so every target measures the same data */
+static inline uint32_t
+bench_random(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+#endif /* _BENCH_H_ */
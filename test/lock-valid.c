@@ -59,6 +59,11 @@ struct __lock __lock___libc_recursive_mutex;
 static struct __lock locks[MAX_LOCKS];
 static uint8_t in_use[MAX_LOCKS];
 
+/* Count of non-recursive locks held, and of times the libc lock was
+ * taken while holding one, for tests checking lock ordering */
+int lock_valid_held;
+int lock_valid_libc_nested;
+
 /* Create a new dynamic non-recursive lock */
 void __retarget_lock_init(_LOCK_T *lock)
 {
@@ -100,12 +105,15 @@ void __retarget_lock_acquire(_LOCK_T lock)
 {
         assert(lock->val == 0);
         lock->val = 1;
+        lock_valid_held++;
 }
 
 /* Acquiure recursive lock */
 void __retarget_lock_acquire_recursive(_LOCK_T lock)
 {
         assert(lock->val >= 0);
+        if (lock == &__lock___libc_recursive_mutex && lock_valid_held)
+                lock_valid_libc_nested++;
         ++(lock->val);
 }
 
@@ -114,6 +122,7 @@ void __retarget_lock_release(_LOCK_T lock)
 {
         assert(lock->val == 1);
         lock->val = 0;
+        lock_valid_held--;
 }
 
 /* Release recursive lock */
@@ -228,6 +228,24 @@ main(void)
             result = 1;
         }
 
+	/* make sure calloc clears memory reused from free */
+
+	char *dirty = malloc(256);
+	if (dirty) {
+		memset(dirty, 0x5a, 256);
+		free(dirty);
+		char *clean = calloc(1, 256);
+		if (clean) {
+			for (pow = 0; pow < 256; pow++)
+				if (clean[pow] != 0) {
+					printf("calloc: memory not cleared at %d (saw %d)\n", pow, clean[pow]);
+					result = 1;
+					break;
+				}
+			free(clean);
+		}
+	}
+
 	/* make sure realloc doesn't read past the source */
 
 	void *big = malloc(1024);
@@ -243,7 +261,7 @@ main(void)
 			char *med = realloc(small, 1024);
 			if (med) {
 //                                printf("med %p\n", med);
-#ifdef __NANO_MALLOC
+#if defined(__NANO_MALLOC) && defined(__NANO_MALLOC_CLEAR_ALLOCATED)
 				int i;
 				for (i = 128; i < 1024; i++)
 					if (med[i] != 0) {
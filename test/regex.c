@@ -66,6 +66,24 @@ const struct test tests[] = {
 	{ .pattern = "x[a-c]*y", .string = "fooxaccabybar",
 	  .ret = 0, .nmatch = 1, .matches = { { .rm_so = 3, .rm_eo = 10 } }
 	},
+	{ .pattern = "^(ab|cd)+$", .string = "abcdab",
+	  .ret = 0, .nmatch = 2, .matches = {
+			{ .rm_so = 0, .rm_eo = 6 },
+			{ .rm_so = 4, .rm_eo = 6 },
+		},
+	},
+	{ .pattern = "warn(ing)?", .string = "a warning here",
+	  .ret = 0, .nmatch = 2, .matches = {
+			{ .rm_so = 2, .rm_eo = 9 },
+			{ .rm_so = 6, .rm_eo = 9 },
+		},
+	},
+	{ .pattern = "x[0-9]+y", .string = "x12z x34y",
+	  .ret = 0, .nmatch = 1, .matches = { { .rm_so = 5, .rm_eo = 9 } }
+	},
+	{ .pattern = "^b", .string = "ab",
+	  .ret = REG_NOMATCH,
+	},
 };
 
 #define NTEST (sizeof(tests)/sizeof(tests[0]))
@@ -0,0 +1,119 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * With semihost-bufio, check that console output still sitting in
+ * the stdout and stderr buffers reaches the host when the program
+ * leaves through _exit. The library's write and exit calls are
+ * replaced here so that the output can be checked before the real
+ * exit call is made.
+ */
+
+#define _GNU_SOURCE
+#include "../../semihost/semihost-private.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/cdefs.h>
+#include <unistd.h>
+
+void __semihost_flush_console(void) __weak;
+
+#define OUT_STRING      "unterminated stdout"
+#define ERR_STRING      "unterminated stderr"
+
+static char written[128];
+static size_t nwritten;
+
+uintptr_t
+sys_semihost_write(int fd, const void *buf, size_t count)
+{
+    size_t n = count;
+
+    if (n > sizeof(written) - nwritten)
+        n = sizeof(written) - nwritten;
+    memcpy(written + nwritten, buf, n);
+    nwritten += n;
+    return sys_semihost3(SYS_WRITE, fd, (sh_param_t)(uintptr_t)buf, count);
+}
+
+/* Turn a successful exit into a failure if the output was lost */
+static uintptr_t
+check_output(uintptr_t code)
+{
+    if (code == 0 && !(memmem(written, nwritten, OUT_STRING, sizeof(OUT_STRING) - 1) &&
+                       memmem(written, nwritten, ERR_STRING, sizeof(ERR_STRING) - 1)))
+        code = 1;
+    return code;
+}
+
+__noreturn void
+sys_semihost_exit_extended(uintptr_t code)
+{
+    (void) sys_semihost2(SYS_EXIT_EXTENDED, ADP_Stopped_ApplicationExit, check_output(code));
+    __builtin_unreachable();
+}
+
+__noreturn void
+sys_semihost_exit(uintptr_t exception, uintptr_t subcode)
+{
+    if (check_output(subcode) != subcode) {
+        exception = ADP_Stopped_RunTimeErrorUnknown;
+        subcode = 1;
+    }
+    if (sizeof(sh_param_t) == 8)
+        (void) sys_semihost2(SYS_EXIT, exception, subcode);
+    else
+        (void) sys_semihost(SYS_EXIT, exception);
+    __builtin_unreachable();
+}
+
+int
+main(void)
+{
+    if (!__semihost_flush_console) {
+        printf("console is not buffered, skipping\n");
+        return 77;
+    }
+
+    fputs(OUT_STRING, stdout);
+    fputs(ERR_STRING, stderr);
+
+    /* Without newlines, both strings stay in the line buffers */
+    if (nwritten != 0) {
+        printf("\noutput written before exit\n");
+        return 1;
+    }
+    _exit(0);
+}
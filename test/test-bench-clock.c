@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <picolibc/bench.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NREAD   1000
+
+/* Keep the loop below from being optimized away */
+static volatile unsigned spin;
+
+int
+main(void)
+{
+    struct bench_timer t;
+    uint64_t prev, now, overhead, freq, elapsed;
+    unsigned long loops;
+    int i;
+    int ret = 0;
+
+    /* The counter must never go backwards */
+    prev = bench_cycles();
+    for (i = 0; i < NREAD; i++) {
+        now = bench_cycles();
+        if (now < prev) {
+            printf("counter went backwards: %llu after %llu\n",
+                   (unsigned long long) now, (unsigned long long) prev);
+            ret = 1;
+        }
+        prev = now;
+    }
+
+    /* Calibration must remove the whole cost of an empty interval */
+    overhead = bench_overhead();
+    if (bench_overhead() != overhead) {
+        printf("overhead changed between calls\n");
+        ret = 1;
+    }
+    for (i = 0; i < 16; i++) {
+        bench_start(&t);
+        bench_stop(&t);
+        if (t.stop - t.start < overhead) {
+            printf("empty interval %llu below overhead %llu\n",
+                   (unsigned long long) (t.stop - t.start),
+                   (unsigned long long) overhead);
+            ret = 1;
+        }
+    }
+
+    /* Spin until the counter advances; coarse fallbacks take a while */
+    bench_start(&t);
+    for (loops = 0; loops < 1000000000UL; loops++) {
+        spin++;
+        bench_stop(&t);
+        if (bench_elapsed(&t) > 0)
+            break;
+    }
+    elapsed = bench_elapsed(&t);
+    if (elapsed == 0) {
+        printf("counter never advanced\n");
+        ret = 1;
+    }
+
+    freq = bench_cycles_per_sec();
+    printf("overhead %llu elapsed %llu after %lu loops, %llu ticks/sec\n",
+           (unsigned long long) overhead, (unsigned long long) elapsed,
+           loops, (unsigned long long) freq);
+    return ret;
+}
@@ -0,0 +1,140 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Read a file through fopen in "r" mode, which maps it into memory
+ * when stdio-mmap is enabled and the system supports it, and check
+ * reads, seeks, ungetc, fileno and freopen. Everything here must
+ * behave the same whether or not the file was mapped.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef TEST_FILE_NAME
+#define TEST_FILE_NAME "FOPENMAP.TXT"
+#endif
+
+#define check(condition, message) do {                  \
+        if (!(condition)) {                             \
+            printf("%s: %s\n", message, #condition);    \
+            ret = 1;                                    \
+            goto done;                                  \
+        }                                               \
+    } while(0)
+
+static const char contents[] =
+    "first line\n"
+    "second line, which is somewhat longer than the first\n"
+    "12 34 five\n"
+    "last line without newline";
+
+int
+main(void)
+{
+    FILE        *f;
+    char        buf[128];
+    int         a, b;
+    int         ret = 0;
+    long        end = (long) sizeof(contents) - 1;
+
+    f = fopen(TEST_FILE_NAME, "w");
+    if (!f) {
+        printf("failed to create %s\n", TEST_FILE_NAME);
+        return 1;
+    }
+    fputs(contents, f);
+    fclose(f);
+
+    f = fopen(TEST_FILE_NAME, "r");
+    check(f != NULL, "fopen");
+
+    /* Reads */
+    check(fgetc(f) == 'f', "fgetc");
+    check(fgets(buf, sizeof(buf), f) && strcmp(buf, "irst line\n") == 0, "fgets");
+    check(fread(buf, 1, 7, f) == 7 && memcmp(buf, "second ", 7) == 0, "fread");
+    check(ftell(f) == 18, "ftell after reads");
+
+    /* ungetc and the position it reports */
+    check(ungetc('X', f) == 'X', "ungetc");
+    check(ftell(f) == 17, "ftell after ungetc");
+    check(fgetc(f) == 'X', "fgetc after ungetc");
+    check(fgetc(f) == 'l', "fgetc after ungetc data");
+
+    /* Seeks within the file */
+    check(fseek(f, 0, SEEK_SET) == 0 && fgetc(f) == 'f', "fseek set");
+    check(fseek(f, 9, SEEK_CUR) == 0 && fgetc(f) == '\n', "fseek cur");
+    check(fseek(f, -4, SEEK_END) == 0 && fgets(buf, sizeof(buf), f) &&
+          strcmp(buf, "line") == 0, "fseek end");
+    check(fgetc(f) == EOF && feof(f), "eof");
+    check(fseek(f, 64, SEEK_SET) == 0, "fseek back after eof");
+    check(fscanf(f, "%d %d", &a, &b) == 2 && a == 12 && b == 34, "fscanf");
+
+    /* Seek past the end, then back */
+    check(fseek(f, end + 10, SEEK_SET) == 0 && ftell(f) == end + 10, "fseek past end");
+    check(fgetc(f) == EOF, "read past end");
+    clearerr(f);
+    check(fseek(f, 6, SEEK_SET) == 0 && fgets(buf, sizeof(buf), f) &&
+          strcmp(buf, "line\n") == 0, "fseek back from past end");
+
+    /* fflush of an input stream keeps the position */
+    check(fflush(f) == 0 && ftell(f) == 11, "fflush");
+    check(fgetc(f) == 's', "read after fflush");
+
+    /* fileno */
+    check(fileno(f) >= 0, "fileno");
+
+    /* freopen to read the file again from the start */
+    f = freopen(TEST_FILE_NAME, "r", f);
+    check(f != NULL, "freopen read");
+    check(fgets(buf, sizeof(buf), f) && strcmp(buf, "first line\n") == 0, "read after freopen");
+    check(fileno(f) >= 0, "fileno after freopen");
+
+    /* and to replace it */
+    f = freopen(TEST_FILE_NAME, "w", f);
+    check(f != NULL, "freopen write");
+    check(fputs("new", f) >= 0, "write after freopen");
+    fclose(f);
+
+    f = fopen(TEST_FILE_NAME, "r");
+    check(f != NULL, "fopen rewritten");
+    check(fgets(buf, sizeof(buf), f) && strcmp(buf, "new") == 0, "rewritten contents");
+    fclose(f);
+
+done:
+    (void) remove(TEST_FILE_NAME);
+    return ret;
+}
@@ -0,0 +1,199 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Build whichever hsearch implementation the library does not use
+ * from hcreate_r.c into this test, renaming its symbols, and check
+ * that the two give the same answers for the same sequence of
+ * operations. The tables are created far too small so that the
+ * open-addressing one has to grow several times.
+ */
+
+#define _DEFAULT_SOURCE
+#include <search.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __HSEARCH_OPEN_ADDRESSING
+#undef __HSEARCH_OPEN_ADDRESSING
+#define ALT_NAME        "chained"
+#else
+#define __HSEARCH_OPEN_ADDRESSING
+#define ALT_NAME        "open addressing"
+#endif
+
+/* The other implementation, with its own hsearch_data type */
+#define internal_head   alt_head
+#define hsearch_data    alt_hsearch_data
+#define hcreate_r       alt_hcreate_r
+#define hdestroy_r      alt_hdestroy_r
+#define hsearch_r       alt_hsearch_r
+
+struct alt_hsearch_data {
+    struct alt_head *htable;
+    size_t htablesize;
+};
+
+int alt_hcreate_r(size_t, struct alt_hsearch_data *);
+void alt_hdestroy_r(struct alt_hsearch_data *);
+int alt_hsearch_r(ENTRY, ACTION, ENTRY **, struct alt_hsearch_data *);
+
+/* hcreate_r.c sets this itself */
+#undef _DEFAULT_SOURCE
+#include "../newlib/libc/search/hcreate_r.c"
+
+#undef internal_head
+#undef hsearch_data
+#undef hcreate_r
+#undef hdestroy_r
+#undef hsearch_r
+
+#define NUM_KEYS   2000
+#define KEYLEN  12
+
+static char keys[NUM_KEYS][KEYLEN];
+static ENTRY *first_lib[NUM_KEYS];
+
+static struct hsearch_data lib;
+static struct alt_hsearch_data alt;
+
+/*
+ * Run one operation on both tables and compare the results. Entries
+ * are compared by key and data as the two tables allocate them
+ * differently. The library's entry is returned in lib_ent
+ */
+static int
+both(const char *key, void *data, ACTION action, ENTRY **lib_ent)
+{
+    ENTRY item, *l_ent, *a_ent;
+    int l_ret, a_ret;
+
+    item.key = (char *) key;
+    item.data = data;
+    l_ret = hsearch_r(item, action, &l_ent, &lib);
+    a_ret = alt_hsearch_r(item, action, &a_ent, &alt);
+
+    if (l_ret != a_ret) {
+        printf("%s %s: library returned %d, %s %d\n",
+               action == FIND ? "find" : "enter", key, l_ret, ALT_NAME, a_ret);
+        return -1;
+    }
+    if (l_ret) {
+        if (strcmp(l_ent->key, key) != 0 || strcmp(a_ent->key, key) != 0 ||
+            l_ent->data != a_ent->data) {
+            printf("%s %s: entries differ (%s %p, %s %p)\n",
+                   action == FIND ? "find" : "enter", key,
+                   l_ent->key, l_ent->data, a_ent->key, a_ent->data);
+            return -1;
+        }
+    } else if (l_ent != NULL || a_ent != NULL) {
+        printf("%s %s: failure left an entry\n",
+               action == FIND ? "find" : "enter", key);
+        return -1;
+    }
+    if (lib_ent)
+        *lib_ent = l_ent;
+    return l_ret;
+}
+
+int
+main(void)
+{
+    char key[KEYLEN];
+    uint32_t seed = 0x12345678;
+    int errors = 0;
+    int i;
+
+    if (!hcreate_r(4, &lib) || !alt_hcreate_r(4, &alt)) {
+        printf("hcreate_r failed\n");
+        return 1;
+    }
+
+    for (i = 0; i < NUM_KEYS; i++)
+        snprintf(keys[i], KEYLEN, "k%x", (unsigned) (i * 2654435761u));
+
+    /* Insert in a scrambled order, looking up earlier keys on the way */
+    for (i = 0; i < NUM_KEYS; i++) {
+        int k = (int) ((i * 7919u) % NUM_KEYS);
+        int old;
+
+        if (both(keys[k], &keys[k], ENTER, &first_lib[k]) != 1)
+            errors++;
+
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        old = (int) (seed % NUM_KEYS);
+        strcpy(key, keys[old]);
+        if (both(key, NULL, FIND, NULL) < 0)
+            errors++;
+    }
+
+    /* Every key is found, from a copy, at the same entry as before */
+    for (i = 0; i < NUM_KEYS; i++) {
+        ENTRY *ent;
+
+        strcpy(key, keys[i]);
+        if (both(key, NULL, FIND, &ent) != 1 || ent != first_lib[i])
+            errors++;
+    }
+
+    /* ENTER of an existing key keeps the original data */
+    for (i = 0; i < NUM_KEYS; i += 13) {
+        ENTRY *ent;
+
+        if (both(keys[i], NULL, ENTER, &ent) != 1 || ent != first_lib[i] ||
+            ent->data != &keys[i])
+            errors++;
+    }
+
+    /* Keys which were never entered */
+    for (i = 0; i < NUM_KEYS; i++) {
+        snprintf(key, KEYLEN, "m%x", (unsigned) i);
+        if (both(key, NULL, FIND, NULL) != 0)
+            errors++;
+    }
+    if (both("", NULL, FIND, NULL) != 0)
+        errors++;
+
+    hdestroy_r(&lib);
+    alt_hdestroy_r(&alt);
+
+    if (errors)
+        printf("%d errors\n", errors);
+    return errors != 0;
+}
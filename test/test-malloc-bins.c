@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check that chunks held in the nano-malloc bins are still merged
+ * with their neighbours: freeing many bin-sized blocks must leave
+ * enough contiguous space for a larger allocation without growing
+ * the heap, and realloc must be able to grow into a binned neighbour
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+
+#if defined(__NANO_MALLOC) && defined(__NANO_MALLOC_BINS)
+
+#define NSMALL  64
+
+static void *small[NSMALL];
+
+static size_t
+arena(void)
+{
+    return mallinfo().arena;
+}
+
+static int
+check_free_then_large(void)
+{
+    size_t      total = 0;
+    size_t      before;
+    void        *guard, *big;
+    int         i;
+
+    for (i = 0; i < NSMALL; i++) {
+        size_t size = 1 + (i % 24);
+        small[i] = malloc(size);
+        if (!small[i]) {
+            printf("malloc(%zu) failed\n", size);
+            return 1;
+        }
+        memset(small[i], i, size);
+        total += size;
+    }
+    /* Keep the freed space away from the top of the heap */
+    guard = malloc(16);
+    before = arena();
+
+    /* Free every other block first so the bins fill with
+     * non-adjacent chunks, then the rest
+     */
+    for (i = 0; i < NSMALL; i += 2)
+        free(small[i]);
+    for (i = 1; i < NSMALL; i += 2)
+        free(small[i]);
+
+    big = malloc(total);
+    if (!big) {
+        printf("malloc(%zu) failed\n", total);
+        return 1;
+    }
+    if (arena() != before) {
+        printf("heap grew from %zu to %zu allocating %zu after freeing small blocks\n",
+               before, arena(), total);
+        return 1;
+    }
+    free(big);
+    free(guard);
+    return 0;
+}
+
+static int
+check_realloc(void)
+{
+    char        *a, *b, *guard, *c;
+    size_t      before;
+    int         i;
+
+    a = malloc(24);
+    b = malloc(24);
+    guard = malloc(24);
+    if (!a || !b || !guard) {
+        printf("malloc failed\n");
+        return 1;
+    }
+    memset(a, 'a', 24);
+    before = arena();
+
+    /* b lands in a bin; a should grow into it in place */
+    free(b);
+    c = realloc(a, 48);
+    if (c != a) {
+        printf("realloc moved %p to %p instead of growing into binned neighbour\n",
+               (void *) a, (void *) c);
+        return 1;
+    }
+    for (i = 0; i < 24; i++)
+        if (c[i] != 'a') {
+            printf("realloc lost contents at %d\n", i);
+            return 1;
+        }
+    if (arena() != before) {
+        printf("heap grew from %zu to %zu in realloc\n", before, arena());
+        return 1;
+    }
+
+    /* Shrink and re-grow the block within the space it now holds */
+    for (i = 0; i < 32; i++) {
+        c = realloc(c, 8 + (i % 4) * 12);
+        if (!c) {
+            printf("realloc failed\n");
+            return 1;
+        }
+        if (c[0] != 'a') {
+            printf("realloc lost contents at step %d\n", i);
+            return 1;
+        }
+    }
+    if (arena() != before) {
+        printf("heap grew from %zu to %zu in realloc loop\n", before, arena());
+        return 1;
+    }
+    free(c);
+    free(guard);
+    return 0;
+}
+
+int
+main(void)
+{
+    int ret = 0;
+
+    ret |= check_free_then_large();
+    ret |= check_realloc();
+    return ret;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("skipping malloc bins test\n");
+    return 77;
+}
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Exercise the nano-malloc per-thread caches from two threads:
+ * blocks cached by another thread must be counted as free by
+ * mallinfo, concurrent malloc and free including frees of blocks
+ * allocated by the other thread must not hand out overlapping
+ * blocks, and double frees of any cached block must be caught.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <malloc.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+#if ((__GNUC__ == 4 && __GNUC_MINOR__ >= 2) || __GNUC__ > 4)
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wunknown-warning-option"
+#pragma GCC diagnostic ignored "-Wuse-after-free"
+#pragma GCC diagnostic ignored "-Wanalyzer-double-free"
+#endif
+
+#if defined(__NANO_MALLOC_TCACHE) && !defined(__SINGLE_THREAD)
+
+int
+start_thread(void *(*func)(void *), void *arg);
+
+int
+stop_thread(void);
+
+#define check(condition, message) do {                  \
+        if (!(condition)) {                             \
+            printf("%s: %s\n", message, #condition);    \
+            exit(1);                                    \
+        }                                               \
+    } while(0)
+
+#define NCACHED (__NANO_MALLOC_TCACHE < 8 ? __NANO_MALLOC_TCACHE : 8)
+#define NSLOT   64
+#define NITER   20000
+
+static void *cached[NCACHED];
+static _Atomic int stage;
+static void *_Atomic slots[NSLOT];
+
+static void
+wait_stage(int s)
+{
+    while (atomic_load(&stage) != s)
+        usleep(100);
+}
+
+/* Each block holds its size followed by bytes set to that size */
+static void *
+make_block(uint32_t *seed)
+{
+    size_t      size;
+    uint8_t     *p;
+
+    *seed = *seed * 1103515245 + 12345;
+    size = sizeof(size_t) + (*seed >> 16) % 96;
+    p = malloc(size);
+    check(p != NULL, "malloc failed");
+    memcpy(p, &size, sizeof(size_t));
+    memset(p + sizeof(size_t), (uint8_t) size, size - sizeof(size_t));
+    return p;
+}
+
+static void
+free_block(void *b)
+{
+    uint8_t     *p = b;
+    size_t      size, i;
+
+    if (!p)
+        return;
+    memcpy(&size, p, sizeof(size_t));
+    for (i = sizeof(size_t); i < size; i++)
+        check(p[i] == (uint8_t) size, "block overwritten");
+    free(p);
+}
+
+static void
+stress(uint32_t seed)
+{
+    int i;
+
+    for (i = 0; i < NITER; i++) {
+        void *b = make_block(&seed);
+        free_block(atomic_exchange(&slots[(seed >> 8) % NSLOT], b));
+    }
+}
+
+static void *
+thread_func(void *arg)
+{
+    int i;
+
+    (void) arg;
+    for (i = 0; i < NCACHED; i++) {
+        cached[i] = malloc(16);
+        check(cached[i] != NULL, "malloc failed");
+    }
+    atomic_store(&stage, 1);
+    wait_stage(2);
+
+    /* These stay in this thread's cache */
+    for (i = 0; i < NCACHED; i++)
+        free(cached[i]);
+    atomic_store(&stage, 3);
+    wait_stage(4);
+
+    stress(2);
+    __malloc_tcache_flush();
+    return NULL;
+}
+
+int
+main(void)
+{
+    struct mallinfo     before, after;
+    int                 i;
+
+    check(start_thread(thread_func, NULL) == 0, "start_thread failed");
+
+    wait_stage(1);
+    before = mallinfo();
+    atomic_store(&stage, 2);
+    wait_stage(3);
+    after = mallinfo();
+    check(after.uordblks + NCACHED * 16 <= before.uordblks,
+          "blocks cached by other thread not counted as free");
+
+    atomic_store(&stage, 4);
+    stress(1);
+    check(stop_thread() == 0, "stop_thread failed");
+
+    for (i = 0; i < NSLOT; i++)
+        free_block(atomic_exchange(&slots[i], NULL));
+    __malloc_tcache_flush();
+
+#if __NANO_MALLOC_TCACHE >= 2
+    {
+        void *p = malloc(16);
+        void *q = malloc(16);
+
+        free(p);
+        free(q);
+        errno = 0;
+        free(p);
+        check(errno == ENOMEM, "double free not detected");
+        __malloc_tcache_flush();
+    }
+#endif
+
+    printf("malloc tcache test passed\n");
+    return 0;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("skipping malloc tcache test\n");
+    return 77;
+}
+
+#endif
@@ -0,0 +1,201 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Run malloc, calloc, realloc and free from two threads at once,
+ * passing blocks between them. Each block is filled with a pattern
+ * which must be intact when it is resized or freed, so blocks handed
+ * out twice or merged while in use are caught.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <malloc.h>
+#include <stdatomic.h>
+
+#ifndef __SINGLE_THREAD
+
+int
+start_thread(void *(*func)(void *), void *arg);
+
+int
+stop_thread(void);
+
+#define check(condition, message) do {                  \
+        if (!(condition)) {                             \
+            printf("%s: %s\n", message, #condition);    \
+            exit(1);                                    \
+        }                                               \
+    } while(0)
+
+#define NSLOT   64
+#define NITER   50000
+
+static void *_Atomic slots[NSLOT];
+static _Atomic int ready;
+
+static uint32_t
+next(uint32_t *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static void
+fill(uint8_t *p, size_t size)
+{
+    memcpy(p, &size, sizeof(size_t));
+    memset(p + sizeof(size_t), (uint8_t) size, size - sizeof(size_t));
+}
+
+/* Each block holds its size followed by bytes set to that size */
+static size_t
+verify(const uint8_t *p)
+{
+    size_t size, i;
+
+    memcpy(&size, p, sizeof(size_t));
+    for (i = sizeof(size_t); i < size; i++)
+        check(p[i] == (uint8_t) size, "block overwritten");
+    return size;
+}
+
+static void *
+make_block(uint32_t *seed)
+{
+    size_t      size = sizeof(size_t) + next(seed) % 200;
+    uint8_t     *p;
+
+    if (next(seed) & 1) {
+        p = calloc(1, size);
+        check(p != NULL, "calloc failed");
+        check(p[size - 1] == 0, "calloc not cleared");
+    } else {
+        p = malloc(size);
+        check(p != NULL, "malloc failed");
+    }
+    fill(p, size);
+    return p;
+}
+
+static void *
+resize_block(uint8_t *p, uint32_t *seed)
+{
+    size_t      size = verify(p);
+    size_t      new_size = sizeof(size_t) + next(seed) % 400;
+    size_t      keep = size < new_size ? size : new_size;
+    size_t      i;
+
+    p = realloc(p, new_size);
+    check(p != NULL, "realloc failed");
+    for (i = sizeof(size_t); i < keep; i++)
+        check(p[i] == (uint8_t) size, "realloc lost contents");
+    fill(p, new_size);
+    return p;
+}
+
+static void
+free_block(void *p)
+{
+    if (!p)
+        return;
+    verify(p);
+    free(p);
+}
+
+static void
+stress(uint32_t seed)
+{
+    int i;
+
+    atomic_fetch_add(&ready, 1);
+    while (atomic_load(&ready) < 2)
+        ;
+    for (i = 0; i < NITER; i++) {
+        void *_Atomic *slot = &slots[next(&seed) % NSLOT];
+        void *b = atomic_exchange(slot, NULL);
+
+        /* Blocks freed here were often allocated by the other thread */
+        if (b && (next(&seed) & 3) == 0)
+            b = resize_block(b, &seed);
+        else {
+            free_block(b);
+            b = make_block(&seed);
+        }
+        free_block(atomic_exchange(slot, b));
+    }
+    /* Return cached blocks while the other thread may still be running */
+#ifdef __NANO_MALLOC_TCACHE
+    __malloc_tcache_flush();
+#endif
+}
+
+static void *
+thread_func(void *arg)
+{
+    (void) arg;
+    stress(2);
+    return NULL;
+}
+
+int
+main(void)
+{
+    int i;
+
+    check(start_thread(thread_func, NULL) == 0, "start_thread failed");
+    stress(1);
+    check(stop_thread() == 0, "stop_thread failed");
+
+    for (i = 0; i < NSLOT; i++)
+        free_block(atomic_exchange(&slots[i], NULL));
+
+    printf("malloc threads test passed\n");
+    return 0;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("Single thread mode, test skipped\n");
+    return 77;
+}
+
+#endif
@@ -0,0 +1,245 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Count qsort comparisons over sorted, reversed, organ-pipe, random
+ * and McIlroy "antiqsort" adversarial inputs for several element
+ * sizes, checking that the results are sorted and that the counts
+ * stay within a small multiple of n log2 n.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define N       4096
+#define MAXSIZE 24
+
+static unsigned char data[N * MAXSIZE] __attribute__((aligned(16)));
+static unsigned long ncompare;
+
+static int
+key(const void *p)
+{
+    int k;
+
+    memcpy(&k, p, sizeof(k));
+    return k;
+}
+
+static int
+compare(const void *a, const void *b)
+{
+    int x = key(a), y = key(b);
+
+    ncompare++;
+    return (x > y) - (x < y);
+}
+
+static int
+compare_r(const void *a, const void *b, void *arg)
+{
+    (*(unsigned long *) arg)++;
+    return compare(a, b);
+}
+
+/*
+ * McIlroy's adversary, "A Killer Adversary for Quicksort". Values
+ * are decided lazily: everything starts out as "gas" (larger than
+ * any solid value) and elements are frozen as the sort compares
+ * them, in the order that hurts a quicksort most.
+ */
+static int      adv_val[N];
+static int      adv_gas, adv_nsolid, adv_candidate;
+
+static int
+compare_adversary(const void *a, const void *b)
+{
+    int x = key(a), y = key(b);
+
+    ncompare++;
+    if (adv_val[x] == adv_gas && adv_val[y] == adv_gas) {
+        if (x == adv_candidate)
+            adv_val[x] = adv_nsolid++;
+        else
+            adv_val[y] = adv_nsolid++;
+    }
+    if (adv_val[x] == adv_gas)
+        adv_candidate = x;
+    else if (adv_val[y] == adv_gas)
+        adv_candidate = y;
+    return (adv_val[x] > adv_val[y]) - (adv_val[x] < adv_val[y]);
+}
+
+static void
+set_key(size_t i, size_t size, int k)
+{
+    memset(data + i * size, 0, size);
+    memcpy(data + i * size, &k, sizeof(k));
+}
+
+enum pattern { SORTED, REVERSED, ORGAN_PIPE, RANDOM, EQUAL, ADVERSARY, NPATTERN };
+
+static const char *const pattern_names[NPATTERN] = {
+    "sorted", "reversed", "organ-pipe", "random", "equal", "adversary"
+};
+
+static void
+fill(enum pattern pattern, size_t n, size_t size)
+{
+    unsigned state = 12345;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        int k;
+
+        switch (pattern) {
+        case SORTED:
+        default:
+            k = i;
+            break;
+        case REVERSED:
+            k = n - i;
+            break;
+        case ORGAN_PIPE:
+            k = i < n / 2 ? i : n - i;
+            break;
+        case RANDOM:
+            state = state * 1103515245 + 12345;
+            k = (state >> 8) % n;
+            break;
+        case EQUAL:
+            k = 7;
+            break;
+        case ADVERSARY:
+            k = i;
+            adv_val[i] = n;
+            break;
+        }
+        set_key(i, size, k);
+    }
+    adv_gas = n;
+    adv_nsolid = 0;
+    adv_candidate = 0;
+    if (pattern == ADVERSARY && n >= 2) {
+        /* Start with a descent so that the presorted check gives up */
+        adv_val[0] = 1;
+        adv_val[1] = 0;
+        adv_nsolid = 2;
+    }
+}
+
+static int
+check_sorted(size_t n, size_t size, int adversary)
+{
+    size_t i;
+
+    for (i = 1; i < n; i++) {
+        int x = key(data + (i - 1) * size), y = key(data + i * size);
+        if (adversary) {
+            x = adv_val[x];
+            y = adv_val[y];
+        }
+        if (x > y)
+            return 0;
+    }
+    return 1;
+}
+
+int
+main(void)
+{
+    static const size_t sizes[] = { 4, 8, 12, 16, 24 };
+    int ret = 0;
+    unsigned log2n = 0;
+    unsigned long limit;
+    size_t s;
+    int p;
+
+    for (s = N; s > 1; s >>= 1)
+        log2n++;
+    limit = 3UL * N * log2n;
+
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t size = sizes[s];
+
+        for (p = 0; p < NPATTERN; p++) {
+            unsigned long ncompare_r = 0;
+
+            fill(p, N, size);
+            ncompare = 0;
+            qsort(data, N, size, p == ADVERSARY ? compare_adversary : compare);
+            if (!check_sorted(N, size, p == ADVERSARY)) {
+                printf("qsort %s size %zu: not sorted\n", pattern_names[p], size);
+                ret = 1;
+            }
+            if (size == 4)
+                printf("%-10s n %d: %lu comparisons (%.2f n log2 n)\n",
+                       pattern_names[p], N, ncompare,
+                       (double) ncompare / ((double) N * log2n));
+            if (ncompare > limit) {
+                printf("qsort %s size %zu: %lu comparisons exceeds %lu\n",
+                       pattern_names[p], size, ncompare, limit);
+                ret = 1;
+            }
+
+            if (p == ADVERSARY)
+                continue;
+            fill(p, N, size);
+            qsort_r(data, N, size, compare_r, &ncompare_r);
+            if (!check_sorted(N, size, 0) || ncompare_r > limit) {
+                printf("qsort_r %s size %zu: failed (%lu comparisons)\n",
+                       pattern_names[p], size, ncompare_r);
+                ret = 1;
+            }
+        }
+    }
+
+    /* Short arrays */
+    for (s = 0; s < 64; s++) {
+        for (p = 0; p < NPATTERN; p++) {
+            if (p == ADVERSARY)
+                continue;
+            fill(p, s, 8);
+            qsort(data, s, 8, compare);
+            if (!check_sorted(s, 8, 0)) {
+                printf("qsort %s n %zu: not sorted\n", pattern_names[p], s);
+                ret = 1;
+            }
+        }
+    }
+    return ret;
+}
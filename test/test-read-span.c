@@ -0,0 +1,178 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check the stdio peek/consume span hooks through a bufio stream
+ * with a small buffer, and that getdelim doesn't call realloc while
+ * holding the buffer lock, using the lock nesting count kept by
+ * lock-valid.c.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <sys/cdefs.h>
+
+#if defined(__TINY_STDIO) && defined(__STDIO_READ_SPAN)
+
+#include <stdio-bufio.h>
+
+#define check(condition, message) do {                  \
+        if (!(condition)) {                             \
+            printf("%s: %s\n", message, #condition);    \
+            exit(1);                                    \
+        }                                               \
+    } while(0)
+
+/* Maintained by lock-valid.c, which is linked with the tests */
+extern int lock_valid_libc_nested __weak;
+
+static bool
+realloc_under_lock(void)
+{
+    return &lock_valid_libc_nested != NULL && lock_valid_libc_nested != 0;
+}
+
+static const char *src;
+static size_t src_len;
+
+static ssize_t
+src_read(void *ptr, void *buf, size_t count)
+{
+    (void) ptr;
+    if (count > src_len)
+        count = src_len;
+    memcpy(buf, src, count);
+    src += count;
+    src_len -= count;
+    return count;
+}
+
+static char     bbuf[16];
+
+static struct __file_bufio bfile =
+    FDEV_SETUP_BUFIO_PTR(NULL, bbuf, sizeof(bbuf), src_read, NULL, NULL, NULL, __SRD, 0);
+
+static FILE *
+reset(const char *s)
+{
+    FILE *f = &bfile.xfile.cfile.file;
+
+    src = s;
+    src_len = strlen(s);
+    bfile.len = bfile.off = 0;
+    f->flags &= ~(__SEOF | __SERR);
+    return f;
+}
+
+static const char lines[] =
+    "short\n"
+    "a line which is much longer than both the bufio buffer and the getdelim increment\n"
+    "\n"
+    "0123456789abcde\n"
+    "no newline at end";
+
+int
+main(void)
+{
+    FILE        *f;
+    char        *line = NULL;
+    size_t      n = 0;
+    const char  *expect = lines;
+    ssize_t     len;
+    char        buf[40];
+    int         a, b;
+
+    /* getline over lines which do and don't fit the buffer */
+    f = reset(lines);
+    while ((len = getline(&line, &n, f)) >= 0) {
+        const char *nl = strchr(expect, '\n');
+        size_t want = nl ? (size_t) (nl - expect) + 1 : strlen(expect);
+
+        check((size_t) len == want, "getline length");
+        check(memcmp(line, expect, want) == 0, "getline data");
+        check(line[len] == '\0', "getline termination");
+        check(n > (size_t) len, "getline size");
+        expect += want;
+    }
+    check(*expect == '\0', "getline stopped early");
+    check(feof(f), "getline eof");
+    free(line);
+    check(!realloc_under_lock(), "getdelim called realloc while holding the buffer lock");
+
+    /* getdelim with a different delimiter, starting from a small buffer */
+    f = reset("a,bb,,ccccccccccccccccccccccccc,");
+    line = malloc(2);
+    n = 2;
+    check(getdelim(&line, &n, ',', f) == 2 && strcmp(line, "a,") == 0, "getdelim 1");
+    check(getdelim(&line, &n, ',', f) == 3 && strcmp(line, "bb,") == 0, "getdelim 2");
+    check(getdelim(&line, &n, ',', f) == 1 && strcmp(line, ",") == 0, "getdelim 3");
+    check(getdelim(&line, &n, ',', f) == 26 && line[24] == 'c' && line[25] == ',', "getdelim 4");
+    check(getdelim(&line, &n, ',', f) == -1, "getdelim eof");
+    free(line);
+    check(!realloc_under_lock(), "getdelim called realloc while holding the buffer lock");
+
+    /* fgets across buffer boundaries and with short destinations */
+    f = reset(lines);
+    check(fgets(buf, sizeof(buf), f) && strcmp(buf, "short\n") == 0, "fgets 1");
+    check(fgets(buf, 8, f) && strcmp(buf, "a line ") == 0, "fgets short dest");
+    check(fgets(buf, sizeof(buf), f) && strlen(buf) == sizeof(buf) - 1, "fgets long");
+
+    /* fread spanning several buffer fills */
+    f = reset(lines);
+    check(fread(buf, 1, 30, f) == 30 && memcmp(buf, lines, 30) == 0, "fread");
+
+    /* ungetc must be seen before the buffered span */
+    f = reset("12 34");
+    check(getc(f) == '1', "getc");
+    check(ungetc('9', f) == '9', "ungetc");
+    check(fscanf(f, "%d %d", &a, &b) == 2 && a == 92 && b == 34, "fscanf after ungetc");
+
+    printf("read span test passed\n");
+    return 0;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("skipping read span test\n");
+    return 77;
+}
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Share one buffered FILE between two threads. Characters written
+ * with putc from both threads at once must all reach the file, which
+ * depends on the library locks, including the lock each buffered
+ * file creates on first use. Whole lines written and read under
+ * flockfile must not be split or lost.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifndef __SINGLE_THREAD
+
+int
+start_thread(void *(*func)(void *), void *arg);
+
+int
+stop_thread(void);
+
+#define check(condition, message) do {                  \
+        if (!(condition)) {                             \
+            printf("%s: %s\n", message, #condition);    \
+            exit(1);                                    \
+        }                                               \
+    } while(0)
+
+#ifndef TEST_FILE_NAME
+#define TEST_FILE_NAME "THREADS.TXT"
+#endif
+
+/* When __STDIO_LOCKING isn't defined, calls are only atomic under flockfile */
+#if defined(__TINY_STDIO) && !defined(__STDIO_LOCKING)
+#define LOCK(f) flockfile(f)
+#define UNLOCK(f) funlockfile(f)
+#else
+#define LOCK(f)
+#define UNLOCK(f)
+#endif
+
+#define NCHAR   20000
+#define NLINE   2000
+
+static const char *const lines[2] = {
+    "the quick brown fox jumps over the lazy dog\n",
+    "THE FIVE BOXING WIZARDS JUMP QUICKLY\n",
+};
+
+static FILE *f;
+static _Atomic int ready;
+static int nread[2];
+
+/* Start both threads together so they race for the first lock */
+static void
+sync_start(void)
+{
+    atomic_fetch_add(&ready, 1);
+    while (atomic_load(&ready) < 2)
+        ;
+}
+
+static void
+put_chars(int id)
+{
+    int i;
+
+    sync_start();
+    for (i = 0; i < NCHAR; i++)
+        putc('a' + id, f);
+}
+
+static void
+put_lines(int id)
+{
+    int i;
+
+    for (i = 0; i < NLINE; i++) {
+        LOCK(f);
+        if (i & 1)
+            fputs(lines[id], f);
+        else
+            fprintf(f, "%s", lines[id]);
+        UNLOCK(f);
+    }
+}
+
+static void
+get_lines(int id)
+{
+    char buf[128];
+    char *s;
+
+    for (;;) {
+        LOCK(f);
+        s = fgets(buf, sizeof(buf), f);
+        UNLOCK(f);
+        if (!s)
+            break;
+        check(strcmp(buf, lines[0]) == 0 || strcmp(buf, lines[1]) == 0, "line mangled");
+        nread[id]++;
+    }
+}
+
+static void (*phase)(int);
+
+static void *
+thread_func(void *arg)
+{
+    (void) arg;
+    phase(1);
+    return NULL;
+}
+
+/* Run func in both threads */
+static void
+run(void (*func)(int))
+{
+    phase = func;
+    atomic_store(&ready, 0);
+    check(start_thread(thread_func, NULL) == 0, "start_thread failed");
+    func(0);
+    check(stop_thread() == 0, "stop_thread failed");
+}
+
+int
+main(void)
+{
+    int count[2] = { 0, 0 };
+    int c;
+
+    f = fopen(TEST_FILE_NAME, "w");
+    check(f != NULL, "fopen for write failed");
+    run(put_chars);
+    check(fclose(f) == 0, "fclose failed");
+
+    f = fopen(TEST_FILE_NAME, "r");
+    check(f != NULL, "fopen for read failed");
+    while ((c = getc(f)) != EOF) {
+        check(c == 'a' || c == 'b', "unexpected character");
+        count[c - 'a']++;
+    }
+    fclose(f);
+    check(count[0] == NCHAR && count[1] == NCHAR, "characters lost");
+
+    f = fopen(TEST_FILE_NAME, "w");
+    check(f != NULL, "fopen for write failed");
+    run(put_lines);
+    check(fclose(f) == 0, "fclose failed");
+
+    f = fopen(TEST_FILE_NAME, "r");
+    check(f != NULL, "fopen for read failed");
+    run(get_lines);
+    fclose(f);
+    check(nread[0] + nread[1] == 2 * NLINE, "lines lost");
+
+    remove(TEST_FILE_NAME);
+    printf("stdio threads test passed\n");
+    return 0;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("Single thread mode, test skipped\n");
+    return 77;
+}
+
+#endif
@@ -0,0 +1,253 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check the optimized string and memory functions against simple
+ * byte-at-a-time versions over a range of alignments and lengths,
+ * including strings which end right at the end of a page-aligned
+ * block so that the vector loops have to stop at the boundary.
+ */
+
+#define _GNU_SOURCE
+#include <string.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define BLOCK   4096
+#define MAXLEN  160
+#define MAXOFF  64
+
+static char block[BLOCK] __attribute__((aligned(BLOCK)));
+static char other[BLOCK] __attribute__((aligned(BLOCK)));
+static char copy[2 * MAXOFF + MAXLEN + 2 * MAXOFF];
+
+static size_t
+ref_strlen(const char *s)
+{
+    size_t n = 0;
+    while (s[n])
+        n++;
+    return n;
+}
+
+static const void *
+ref_memchr(const void *s, int c, size_t n)
+{
+    const unsigned char *p = s;
+    for (; n; n--, p++)
+        if (*p == (unsigned char) c)
+            return p;
+    return NULL;
+}
+
+static const void *
+ref_memrchr(const void *s, int c, size_t n)
+{
+    const unsigned char *p = s;
+    while (n--)
+        if (p[n] == (unsigned char) c)
+            return p + n;
+    return NULL;
+}
+
+static const char *
+ref_strrchr(const char *s, int c)
+{
+    const char *r = NULL;
+    for (;; s++) {
+        if (*s == (char) c)
+            r = s;
+        if (!*s)
+            return r;
+    }
+}
+
+static int
+ref_strncmp(const char *a, const char *b, size_t n)
+{
+    for (; n; n--, a++, b++) {
+        if (*a != *b)
+            return (unsigned char) *a - (unsigned char) *b;
+        if (!*a)
+            break;
+    }
+    return 0;
+}
+
+static int
+ref_memcmp(const void *a, const void *b, size_t n)
+{
+    const unsigned char *x = a, *y = b;
+    for (; n; n--, x++, y++)
+        if (*x != *y)
+            return *x - *y;
+    return 0;
+}
+
+static int
+sign(int v)
+{
+    return (v > 0) - (v < 0);
+}
+
+static int
+fail(const char *func, int off, int len, long got, long expect)
+{
+    printf("%s off %d len %d: got %ld expect %ld\n", func, off, len, got, expect);
+    return 1;
+}
+
+static long
+pos(const void *p, const void *base)
+{
+    return p ? (long) ((const char *) p - (const char *) base) : -1L;
+}
+
+static int
+check_string(char *s, char *t, int off, int len)
+{
+    int  ret = 0;
+    int  c;
+    long got, expect;
+
+    if (strlen(s) != (size_t) len)
+        ret |= fail("strlen", off, len, strlen(s), len);
+    for (int n = 0; n <= len + 1; n += (n < 40 ? 1 : 17)) {
+        size_t e = (size_t) n < (size_t) len ? (size_t) n : (size_t) len;
+        if (strnlen(s, n) != e)
+            ret |= fail("strnlen", off, n, strnlen(s, n), e);
+    }
+
+    for (c = 0; c < 256; c += 37) {
+        got = pos(strchr(s, c), s);
+        expect = pos(ref_memchr(s, c, len + 1), s);
+        if (got != expect)
+            ret |= fail("strchr", off, len, got, expect);
+        got = pos(strrchr(s, c), s);
+        expect = pos(ref_strrchr(s, c), s);
+        if (got != expect)
+            ret |= fail("strrchr", off, len, got, expect);
+        got = pos(memchr(s, c, len), s);
+        expect = pos(ref_memchr(s, c, len), s);
+        if (got != expect)
+            ret |= fail("memchr", off, len, got, expect);
+        got = pos(memrchr(s, c, len), s);
+        expect = pos(ref_memrchr(s, c, len), s);
+        if (got != expect)
+            ret |= fail("memrchr", off, len, got, expect);
+    }
+
+    /* Compare equal strings, then differ at each position */
+    if (strcmp(s, t) != 0)
+        ret |= fail("strcmp", off, len, strcmp(s, t), 0);
+    for (int d = 0; d < len; d += (d < 40 ? 1 : 13)) {
+        char save = t[d];
+        t[d] = (char) (save ^ 0x80);
+        got = sign(strcmp(s, t));
+        expect = sign(ref_strncmp(s, t, (size_t) -1));
+        if (got != expect)
+            ret |= fail("strcmp", off, d, got, expect);
+        got = sign(strncmp(s, t, d));
+        expect = sign(ref_strncmp(s, t, d));
+        if (got != expect)
+            ret |= fail("strncmp", off, d, got, expect);
+        got = sign(strncmp(s, t, d + 1));
+        expect = sign(ref_strncmp(s, t, d + 1));
+        if (got != expect)
+            ret |= fail("strncmp", off, d + 1, got, expect);
+        got = sign(memcmp(s, t, len));
+        expect = sign(ref_memcmp(s, t, len));
+        if (got != expect)
+            ret |= fail("memcmp", off, len, got, expect);
+        t[d] = save;
+    }
+
+    /* stpcpy */
+    memset(copy, 'z', sizeof(copy));
+    char *dst = copy + MAXOFF + (off & (MAXOFF - 1));
+    char *end = stpcpy(dst, s);
+    if (end != dst + len || ref_memcmp(dst, s, len + 1) != 0 || dst[len + 1] != 'z' || dst[-1] != 'z')
+        ret |= fail("stpcpy", off, len, pos(end, dst), len);
+
+    /* memmove in both directions with overlap */
+    for (int shift = -MAXOFF + 1; shift < MAXOFF; shift += 7) {
+        char ref[sizeof(copy)];
+        for (size_t i = 0; i < sizeof(copy); i++)
+            copy[i] = ref[i] = (char) (i * 7 + 3);
+        char *src = copy + MAXOFF + (off & (MAXOFF - 1));
+        memmove(src + shift, src, len);
+        for (int i = 0; i < len; i++)
+            ref[src - copy + shift + i] = (char) ((src - copy + i) * 7 + 3);
+        if (ref_memcmp(copy, ref, sizeof(copy)) != 0)
+            ret |= fail("memmove", off, len, shift, 0);
+    }
+    return ret;
+}
+
+static void
+fill(char *s, int len, int seed)
+{
+    for (int i = 0; i < len; i++) {
+        char c = (char) ((i * 131 + seed) & 0xff);
+        s[i] = c ? c : 1;
+    }
+    s[len] = '\0';
+}
+
+int
+main(void)
+{
+    int ret = 0;
+
+    for (int len = 0; len < MAXLEN; len += (len < 72 ? 1 : 11)) {
+        /* Strings at the start of the block with varying alignment */
+        for (int off = 0; off < MAXOFF; off++) {
+            char *s = block + off;
+            char *t = other + ((off * 3) & (MAXOFF - 1));
+            fill(s, len, off);
+            memcpy(t, s, len + 1);
+            ret |= check_string(s, t, off, len);
+        }
+        /* Strings ending at the very end of the block */
+        for (int off = 0; off < MAXOFF; off++) {
+            char *s = block + BLOCK - 1 - len - off;
+            char *t = other + BLOCK - 1 - len;
+            fill(s, len, off);
+            memcpy(t, s, len + 1);
+            ret |= check_string(s, t, -off - 1, len);
+        }
+    }
+    return ret;
+}
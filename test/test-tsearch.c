@@ -0,0 +1,201 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Exercise tsearch/tfind/tdelete/twalk/tdestroy, checking that the
+ * tree stays balanced when keys arrive in sorted order. Also reports
+ * the tree depth and comparison count for sorted insertion, which
+ * grew linearly with the old unbalanced tree.
+ */
+
+#define _GNU_SOURCE
+#include <search.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NKEYS   4096
+
+static int keys[NKEYS];
+static unsigned long ncompare;
+static int max_level;
+static int last_key;
+static int nvisit;
+static int order_ok;
+static int nfree;
+
+static int
+compare(const void *a, const void *b)
+{
+    int x = *(const int *) a;
+    int y = *(const int *) b;
+
+    ncompare++;
+    return (x > y) - (x < y);
+}
+
+static void
+walk(const void *node, VISIT v, int level)
+{
+    int key = **(int *const *) node;
+
+    if (level > max_level)
+        max_level = level;
+    if (v == postorder || v == leaf) {
+        if (nvisit && key <= last_key)
+            order_ok = 0;
+        last_key = key;
+        nvisit++;
+    }
+}
+
+static void
+free_key(void *key)
+{
+    (void) key;
+    nfree++;
+}
+
+/* Returns the number of nodes, checking order and depth */
+static int
+check_tree(void *root, const char *when, int expect)
+{
+    int ret = 0;
+    int bound, n;
+
+    max_level = 0;
+    nvisit = 0;
+    order_ok = 1;
+    twalk(root, walk);
+    /* AVL height is below 1.45 * log2(n + 2) */
+    for (bound = 0, n = expect + 2; n > 1; n >>= 1)
+        bound++;
+    bound = bound * 3 / 2 + 1;
+    if (nvisit != expect) {
+        printf("%s: visited %d expected %d\n", when, nvisit, expect);
+        ret = 1;
+    }
+    if (!order_ok) {
+        printf("%s: walk out of order\n", when);
+        ret = 1;
+    }
+    if (max_level > bound) {
+        printf("%s: depth %d exceeds %d\n", when, max_level, bound);
+        ret = 1;
+    }
+    return ret;
+}
+
+int
+main(void)
+{
+    void *root = NULL;
+    int ret = 0;
+    int i, count;
+    unsigned state = 1;
+
+    for (i = 0; i < NKEYS; i++)
+        keys[i] = i;
+
+    ncompare = 0;
+    for (i = 0; i < NKEYS; i++) {
+        int **node = tsearch(&keys[i], &root, compare);
+        if (!node || *node != &keys[i]) {
+            printf("tsearch %d failed\n", i);
+            return 1;
+        }
+    }
+    ret |= check_tree(root, "sorted insert", NKEYS);
+    printf("sorted insert of %d keys: depth %d, %lu comparisons\n",
+           NKEYS, max_level, ncompare);
+
+    /* Duplicates return the existing node */
+    for (i = 0; i < NKEYS; i += 7) {
+        int dup = i;
+        int **node = tsearch(&dup, &root, compare);
+        if (!node || *node != &keys[i]) {
+            printf("tsearch duplicate %d failed\n", i);
+            ret = 1;
+        }
+    }
+
+    /* Delete a pseudo-random half of the keys */
+    count = NKEYS;
+    for (i = 0; i < NKEYS * 2; i++) {
+        int k;
+        state = state * 1103515245 + 12345;
+        k = (state >> 8) % NKEYS;
+        if (keys[k] < 0)
+            continue;
+        if (!tdelete(&keys[k], &root, compare)) {
+            printf("tdelete %d failed\n", k);
+            ret = 1;
+        }
+        keys[k] = -1 - keys[k];
+        count--;
+        if ((count & 255) == 0)
+            ret |= check_tree(root, "delete", count);
+    }
+    ret |= check_tree(root, "after delete", count);
+
+    for (i = 0; i < NKEYS; i++) {
+        int k = keys[i] < 0 ? -1 - keys[i] : keys[i];
+        int **node = tfind(&k, &root, compare);
+        if ((node != NULL) != (keys[i] >= 0)) {
+            printf("tfind %d wrong\n", k);
+            ret = 1;
+        }
+        if (keys[i] < 0 && tdelete(&k, &root, compare) != NULL) {
+            printf("tdelete of missing %d succeeded\n", k);
+            ret = 1;
+        }
+    }
+
+    /* Reinsert the deleted keys in descending order */
+    for (i = NKEYS - 1; i >= 0; i--) {
+        if (keys[i] < 0) {
+            keys[i] = -1 - keys[i];
+            tsearch(&keys[i], &root, compare);
+            count++;
+        }
+    }
+    ret |= check_tree(root, "reinsert", count);
+
+    tdestroy(root, free_key);
+    if (nfree != NKEYS) {
+        printf("tdestroy freed %d expected %d\n", nfree, NKEYS);
+        ret = 1;
+    }
+    return ret;
+}
@@ -0,0 +1,202 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check that the cached TZ rules and DST change-over times are
+ * recomputed when they should be: TZ edited in place, TZ values too
+ * long to be saved and conversions spanning more years than the cache
+ * holds.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/_tz_structs.h>
+
+#define HOUR    ((time_t) 3600)
+#define DAY     (24 * HOUR)
+
+#define NYEARS  (2 * __TZ_YEAR_CACHE + 3)
+#define YEAR0   2001
+
+static int errors;
+
+#define check(c) do { if (!(c)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #c); errors++; } } while (0)
+
+/* UTC time of 00:00 local standard time on the n'th Sunday (n = 5 for the last) of a month */
+static time_t
+nth_sunday(int year, int mon, int n, long offset)
+{
+    struct tm tm = { .tm_mday = 1, .tm_mon = mon, .tm_year = year - 1900 };
+    time_t t = timegm(&tm);
+    int mday = 1 + (7 - tm.tm_wday) % 7 + (n - 1) * 7;
+    static const int mdays[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    while (mday > mdays[mon] + (mon == 1 && year % 4 == 0))
+        mday -= 7;
+    return t + (mday - 1) * DAY + offset;
+}
+
+/* Check the local time at t, and that mktime maps it back */
+static void
+check_time(int line, time_t t, int hour, int isdst)
+{
+    struct tm tm;
+
+    localtime_r(&t, &tm);
+    if (tm.tm_hour != hour || tm.tm_isdst != isdst) {
+        printf("%s:%d: %lld: hour %d isdst %d expect hour %d isdst %d (TZ=%s)\n",
+               __FILE__, line, (long long) t, tm.tm_hour, tm.tm_isdst,
+               hour, isdst, getenv("TZ"));
+        errors++;
+    }
+    if (mktime(&tm) != t) {
+        printf("%s:%d: %lld: mktime mismatch (TZ=%s)\n",
+               __FILE__, line, (long long) t, getenv("TZ"));
+        errors++;
+    }
+}
+
+/*
+ * Check the change-over instants of a rule of the form
+ * STD<std>DST,Mm.n.0,Mm.n.0 with both changes at 02:00 local time
+ */
+static void
+check_year(int line, int year, long std, int start_mon, int start_week,
+           int end_mon, int end_week)
+{
+    time_t start = nth_sunday(year, start_mon, start_week, std * HOUR) + 2 * HOUR;
+    time_t end = nth_sunday(year, end_mon, end_week, (std - 1) * HOUR) + 2 * HOUR;
+
+    /* 01:59:59 standard, then 03:00 daylight */
+    check_time(line, start - 1, 1, 0);
+    check_time(line, start, 3, 1);
+    /* 01:59:59 daylight, then 01:00 standard */
+    check_time(line, end - 1, 1, 1);
+    check_time(line, end, 1, 0);
+}
+
+static void
+check_years(int line, const int *years, int nyears, long std,
+            int start_mon, int start_week, int end_mon, int end_week)
+{
+    int i;
+
+    for (i = 0; i < nyears; i++)
+        check_year(line, years[i], std, start_mon, start_week, end_mon, end_week);
+}
+
+int
+main(void)
+{
+    static char tz_est[] = "TZ=EST5EDT,M3.2.0,M11.1.0";
+    char *tz;
+    time_t end;
+    int years[NYEARS * 3];
+    int i, n;
+
+    /* TZ rewritten in place, keeping the same pointer */
+    if (putenv(tz_est) != 0) {
+        printf("putenv failed\n");
+        return 1;
+    }
+    tz = getenv("TZ");
+    check_year(__LINE__, 2021, 5, 2, 2, 10, 1);
+    memcpy(tz, "PST8PDT", 7);
+    check(getenv("TZ") == tz);
+    check_year(__LINE__, 2021, 8, 2, 2, 10, 1);
+
+    /* putenv of a value which fits reuses the same storage */
+    memcpy(tz_est + 3, "CST6CDT", 7);
+    if (putenv(tz_est) != 0) {
+        printf("putenv failed\n");
+        return 1;
+    }
+    check(getenv("TZ") == tz);
+    check_year(__LINE__, 2021, 6, 2, 2, 10, 1);
+
+    /*
+     * A value too long to be saved for comparison, rewritten in
+     * place beyond the first 64 bytes
+     */
+    if (setenv("TZ", "<ESTSTDTIME>+05:00:00<EDTDSTTIME>+04:00:00,M3.2.0/02:00:00,M11.1.0/02:00:00", 1) != 0) {
+        printf("setenv failed\n");
+        return 1;
+    }
+    tz = getenv("TZ");
+    check(strlen(tz) - 7 >= 64);
+    check_year(__LINE__, 2021, 5, 2, 2, 10, 1);
+    end = nth_sunday(2021, 10, 1, 4 * HOUR) + 2 * HOUR;
+    tz[strlen(tz) - 7] = '3';           /* DST now ends at 03:00 */
+    check(getenv("TZ") == tz);
+    check_time(__LINE__, end, 2, 1);
+    check_time(__LINE__, end + HOUR, 2, 0);
+
+    /*
+     * Hop between more years than the cache holds, in an order which
+     * keeps evicting entries, then change the rules and go again to
+     * make sure no stale change-over times are used.
+     */
+    n = 0;
+    for (i = 0; i < NYEARS; i++)
+        years[n++] = YEAR0 + i;
+    for (i = 0; i < NYEARS; i++)
+        years[n++] = YEAR0 + NYEARS - 1 - i;
+    for (i = 0; i < NYEARS; i++)
+        years[n++] = YEAR0 + (i * 5) % NYEARS;
+
+    setenv("TZ", "EST5EDT,M3.2.0,M11.1.0", 1);
+    check_years(__LINE__, years, n, 5, 2, 2, 10, 1);
+
+    setenv("TZ", "EST5EDT,M4.1.0,M10.5.0", 1);
+    check_years(__LINE__, years, n, 5, 3, 1, 9, 5);
+
+    setenv("TZ", "CET-1CEST,M3.5.0,M10.5.0/3", 1);
+    for (i = 0; i < n; i++) {
+        /* Both changes are at 01:00 UTC */
+        time_t start = nth_sunday(years[i], 2, 5, 0) + HOUR;
+        time_t end = nth_sunday(years[i], 9, 5, 0) + HOUR;
+
+        check_time(__LINE__, start - 1, 1, 0);
+        check_time(__LINE__, start, 3, 1);
+        check_time(__LINE__, end - 1, 2, 1);
+        check_time(__LINE__, end, 2, 0);
+    }
+
+    printf("%d errors\n", errors);
+    return errors != 0;
+}
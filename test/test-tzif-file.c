@@ -0,0 +1,222 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check that TZ=:path loads well-formed TZif files and rejects ones
+ * whose transitions are out of order or whose footer rule does not
+ * fit, rather than giving wrong local times.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __TZIF
+
+#ifndef TEST_FILE_NAME
+#define TEST_FILE_NAME "TZIFFILE.TZ"
+#endif
+
+#define T0      ((int64_t) 1000000000)  /* CST -> EST */
+#define T1      ((int64_t) 1100000000)  /* EST -> CST */
+#define FUTURE  ((time_t) 1909224000)   /* 2030-07-01 12:00 UTC */
+
+/* 63 and 64 bytes; the longest rule accepted is 63 bytes */
+#define RULE_63 "<ESTSTDTIME>+05:00:00<EDTDSTTIME>+04:00:00,M3.2.0/2:0,M11.1.0/2"
+#define RULE_64 "<ESTSTDTIME>+05:00:00<EDTDSTTIME>+04:00:00,M3.2.0/2:00,M11.1.0/2"
+
+static unsigned char image[512];
+static size_t len;
+
+static void
+put8(unsigned v)
+{
+    image[len++] = (unsigned char) v;
+}
+
+static void
+put32(uint32_t v)
+{
+    put8(v >> 24);
+    put8((v >> 16) & 0xff);
+    put8((v >> 8) & 0xff);
+    put8(v & 0xff);
+}
+
+static void
+header(uint32_t timecnt, uint32_t typecnt, uint32_t charcnt)
+{
+    memcpy(image + len, "TZif2", 5);
+    memset(image + len + 5, 0, 15);
+    len += 20;
+    put32(0);           /* isutcnt */
+    put32(0);           /* isstdcnt */
+    put32(0);           /* leapcnt */
+    put32(timecnt);
+    put32(typecnt);
+    put32(charcnt);
+}
+
+/*
+ * Build a version 2 file for a zone in CST until the first time
+ * in times, then alternating between EST and CST
+ */
+static void
+make(const int64_t *times, unsigned ntimes, const char *footer, const char *end)
+{
+    unsigned i;
+
+    len = 0;
+
+    /* Version 1 data, skipped by version 2 readers */
+    header(0, 1, 4);
+    put32(0); put8(0); put8(0);
+    memcpy(image + len, "UTC", 4);
+    len += 4;
+
+    header(ntimes, 2, 8);
+    for (i = 0; i < ntimes; i++) {
+        put32((uint32_t) ((uint64_t) times[i] >> 32));
+        put32((uint32_t) times[i]);
+    }
+    for (i = 0; i < ntimes; i++)
+        put8(i % 2 == 0);
+    put32((uint32_t) -21600); put8(0); put8(0);
+    put32((uint32_t) -18000); put8(0); put8(4);
+    memcpy(image + len, "CST\0EST", 8);
+    len += 8;
+
+    put8('\n');
+    memcpy(image + len, footer, strlen(footer));
+    len += strlen(footer);
+    memcpy(image + len, end, strlen(end));
+    len += strlen(end);
+}
+
+/* Write the image and select it with TZ=:path */
+static int
+load(void)
+{
+    FILE *f;
+
+    /* TZif data is only read again after TZ changes */
+    setenv("TZ", "UTC0", 1);
+    tzset();
+
+    f = fopen(TEST_FILE_NAME, "wb");
+    if (!f)
+        return 0;
+    if (fwrite(image, 1, len, f) != len) {
+        fclose(f);
+        return 0;
+    }
+    if (fclose(f) != 0)
+        return 0;
+    setenv("TZ", ":" TEST_FILE_NAME, 1);
+    tzset();
+    return 1;
+}
+
+static int ret;
+
+static void
+check_zone(int line, time_t t, const char *expect)
+{
+    struct tm tm;
+    char buf[64];
+
+    localtime_r(&t, &tm);
+    strftime(buf, sizeof(buf), "%H:%M %z %Z", &tm);
+    if (strcmp(buf, expect) != 0) {
+        printf("%s:%d: %lld: '%s' expect '%s'\n", __FILE__, line, (long long) t, buf, expect);
+        ret = 1;
+    }
+}
+
+int
+main(void)
+{
+    static const int64_t sorted[] = { T0, T1 };
+    static const int64_t unsorted[] = { T1, T0 };
+    static const int64_t repeated[] = { T0, T0 };
+
+    make(sorted, 2, "CST6", "\n");
+    if (!load()) {
+        printf("cannot write %s\n", TEST_FILE_NAME);
+        return 77;
+    }
+    check_zone(__LINE__, (time_t) T0 - 3600, "18:46 -0600 CST");
+    check_zone(__LINE__, (time_t) T0, "20:46 -0500 EST");
+    check_zone(__LINE__, (time_t) T1 + 7200, "07:33 -0600 CST");
+    check_zone(__LINE__, FUTURE, "06:00 -0600 CST");
+
+    /* Rejected files leave TZ to be read as a POSIX value, which gives UTC */
+    make(unsorted, 2, "CST6", "\n");
+    load();
+    check_zone(__LINE__, (time_t) T0, "01:46 +0000 ");
+
+    make(repeated, 2, "CST6", "\n");
+    load();
+    check_zone(__LINE__, (time_t) T0, "01:46 +0000 ");
+
+    make(sorted, 2, "CST6", "");
+    load();
+    check_zone(__LINE__, (time_t) T0, "01:46 +0000 ");
+
+    make(sorted, 2, RULE_64, "\n");
+    load();
+    check_zone(__LINE__, (time_t) T0, "01:46 +0000 ");
+
+    make(sorted, 2, RULE_63, "\n");
+    load();
+    check_zone(__LINE__, (time_t) T0, "20:46 -0500 EST");
+    check_zone(__LINE__, FUTURE, "08:00 -0400 EDTDSTTIME");
+
+    remove(TEST_FILE_NAME);
+    return ret;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("TZif support not enabled\n");
+    return 77;
+}
+
+#endif
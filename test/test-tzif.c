@@ -0,0 +1,186 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check localtime and mktime against a linked-in TZif image. The
+ * zone has a different standard offset and DST dates in the past
+ * than its footer rule, so the table must be used for those times.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __TZIF
+
+/*
+ * zic -b slim output for:
+ *
+ * Rule	Old	1990	1991	-	Apr	Sun>=1	2:00	1:00	D
+ * Rule	Old	1990	1991	-	Oct	lastSun	2:00	0	S
+ * Rule	New	1992	max	-	Mar	Sun>=8	2:00	1:00	D
+ * Rule	New	1992	max	-	Nov	Sun>=1	2:00	0	S
+ * Zone	Test/Zone	-6:00	-	CST	1990
+ *			-5:00	Old	E%sT	1992
+ *			-5:00	New	E%sT
+ */
+const unsigned char __tzif_builtin[] = {
+    0x54, 0x5a, 0x69, 0x66, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x54, 0x5a, 0x69, 0x66, 0x32, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x0c, 0x00,
+    0x00, 0x00, 0x00, 0x25, 0x9e, 0xf1, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x26,
+    0x15, 0xa6, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x27, 0x2a, 0x73, 0xe0, 0x00,
+    0x00, 0x00, 0x00, 0x27, 0xfe, 0xc3, 0x70, 0x00, 0x00, 0x00, 0x00, 0x29,
+    0x0a, 0x55, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x29, 0xb9, 0xbb, 0x70, 0x02,
+    0x01, 0x02, 0x01, 0x02, 0x01, 0xff, 0xff, 0xab, 0xa0, 0x00, 0x00, 0xff,
+    0xff, 0xc7, 0xc0, 0x01, 0x04, 0xff, 0xff, 0xb9, 0xb0, 0x00, 0x08, 0x43,
+    0x53, 0x54, 0x00, 0x45, 0x44, 0x54, 0x00, 0x45, 0x53, 0x54, 0x00, 0x0a,
+    0x45, 0x53, 0x54, 0x35, 0x45, 0x44, 0x54, 0x2c, 0x4d, 0x33, 0x2e, 0x32,
+    0x2e, 0x30, 0x2c, 0x4d, 0x31, 0x31, 0x2e, 0x31, 0x2e, 0x30, 0x0a
+};
+
+const size_t __tzif_builtin_size = sizeof (__tzif_builtin);
+
+static const struct {
+    time_t      t;
+    int         year, mon, mday, hour, min, isdst;
+    const char  *zone;
+} local[] = {
+    { 489067200, 1985, 7, 1, 6, 0, 0, "-0600 CST" },    /* CST before 1990 */
+    { 646833600, 1990, 7, 1, 8, 0, 1, "-0400 EDT" },
+    { 670507200, 1991, 4, 1, 7, 0, 0, "-0500 EST" },    /* old rules start DST later */
+    { 688545000, 1991, 10, 27, 1, 30, 0, "-0500 EST" }, /* and end it earlier */
+    { 688824000, 1991, 10, 30, 7, 0, 0, "-0500 EST" },
+    { 1893499200, 2030, 1, 1, 7, 0, 0, "-0500 EST" },   /* footer rule */
+    { 1909137600, 2030, 7, 1, 8, 0, 1, "-0400 EDT" },
+};
+
+static const struct {
+    int         year, mon, mday, hour, min, isdst;
+    time_t      t;
+    int         hour_out, isdst_out;
+} mk[] = {
+    { 1991, 4, 7, 2, 30, -1, 671009400, 3, 1 }, /* skipped */
+    { 1991, 10, 27, 1, 30, 0, 688545000, 1, 0 },/* repeated */
+    { 1991, 10, 27, 1, 30, 1, 688541400, 1, 1 },
+    { 1985, 7, 1, 6, 0, -1, 489067200, 6, 0 },
+    { 2030, 7, 1, 8, 0, -1, 1909137600, 8, 1 },
+};
+
+#define check(c) do { if (!(c)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #c); ret = 1; } } while (0)
+
+int
+main(void)
+{
+    int ret = 0;
+    unsigned i;
+
+    unsetenv("TZ");
+    tzset();
+    check(strcmp(tzname[0], "EST") == 0);
+    check(strcmp(tzname[1], "EDT") == 0);
+
+    for (i = 0; i < sizeof(local) / sizeof(local[0]); i++) {
+        struct tm tm;
+        time_t t;
+        char buf[32];
+
+        check(localtime_r(&local[i].t, &tm) != NULL);
+        printf("%lld: %04d-%02d-%02d %02d:%02d isdst %d\n", (long long) local[i].t,
+               tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_isdst);
+        check(tm.tm_year + 1900 == local[i].year);
+        check(tm.tm_mon + 1 == local[i].mon);
+        check(tm.tm_mday == local[i].mday);
+        check(tm.tm_hour == local[i].hour);
+        check(tm.tm_min == local[i].min);
+        check(tm.tm_isdst == local[i].isdst);
+        /* %z and %Z come from the table, not the footer rule */
+        check(strftime(buf, sizeof(buf), "%z %Z", &tm) == strlen(local[i].zone));
+        if (strcmp(buf, local[i].zone) != 0) {
+            printf("%lld: strftime %%z %%Z '%s' expect '%s'\n", (long long) local[i].t,
+                   buf, local[i].zone);
+            ret = 1;
+        }
+        check(strftime(buf, sizeof(buf), "%s", &tm) > 0);
+        check(strtoll(buf, NULL, 10) == (long long) local[i].t);
+        t = mktime(&tm);
+        check(t == local[i].t);
+    }
+
+    for (i = 0; i < sizeof(mk) / sizeof(mk[0]); i++) {
+        struct tm tm = {
+            .tm_year = mk[i].year - 1900,
+            .tm_mon = mk[i].mon - 1,
+            .tm_mday = mk[i].mday,
+            .tm_hour = mk[i].hour,
+            .tm_min = mk[i].min,
+            .tm_isdst = mk[i].isdst,
+        };
+        time_t t = mktime(&tm);
+
+        printf("%04d-%02d-%02d %02d:%02d isdst %d: %lld\n", mk[i].year, mk[i].mon, mk[i].mday,
+               mk[i].hour, mk[i].min, mk[i].isdst, (long long) t);
+        check(t == mk[i].t);
+        check(tm.tm_hour == mk[i].hour_out);
+        check(tm.tm_isdst == mk[i].isdst_out);
+    }
+
+    /* A POSIX TZ value still works */
+    setenv("TZ", "CST6", 1);
+    tzset();
+    {
+        struct tm tm;
+        check(localtime_r(&local[1].t, &tm) != NULL);
+        check(tm.tm_hour == 6 && tm.tm_isdst == 0);
+    }
+    return ret;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("TZif support not enabled\n");
+    return 77;
+}
+
+#endif
@@ -0,0 +1,243 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check the wide character classification and case conversion
+ * functions against the interval tables in ctype_table.h and
+ * caseconv.t for every code point, using the binary searches the
+ * library uses when wctype-tables=search. With wctype-tables set to
+ * small or fast, this checks that the generated multi-stage tables
+ * give the same answers.
+ */
+
+#define _DEFAULT_SOURCE
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <wctype.h>
+
+#ifdef __MB_CAPABLE
+
+#include "../newlib/libc/ctype/local.h"
+
+static const struct {
+    wchar_t             code;
+    uint16_t            category;
+} ctype_table[] = {
+#include "../newlib/libc/ctype/ctype_table.h"
+};
+
+#define N_CAT_TABLE     (sizeof(ctype_table) / sizeof(ctype_table[0]))
+
+static const struct caseconv_entry case_table[] = {
+#include "../newlib/libc/ctype/caseconv.t"
+};
+
+#define N_CASE_TABLE    (sizeof(case_table) / sizeof(case_table[0]))
+
+#if __SIZEOF_WCHAR_T__ == 2
+#define MAX_CODE        0x10000
+#else
+#define MAX_CODE        0x110000
+#endif
+
+static uint16_t
+ref_class(wint_t c)
+{
+    size_t low = 0, high = N_CAT_TABLE;
+
+    /* Last entry with code <= c */
+    while (high - low > 1) {
+        size_t mid = (low + high) / 2;
+        if ((wint_t) ctype_table[mid].code <= c)
+            low = mid;
+        else
+            high = mid;
+    }
+    return ctype_table[low].category;
+}
+
+static const struct caseconv_entry *
+ref_case(wint_t c)
+{
+    size_t low = 0, high = N_CASE_TABLE;
+
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (c < case_table[mid].first)
+            high = mid;
+        else if (c > case_table[mid].first + case_table[mid].diff)
+            low = mid + 1;
+        else
+            return &case_table[mid];
+    }
+    return NULL;
+}
+
+static wint_t
+ref_tolower(wint_t c)
+{
+    const struct caseconv_entry *ce = ref_case(c);
+
+    if (ce) {
+        switch (ce->mode) {
+        case TOLO:
+            return c + ce->delta;
+        case TOBOTH:
+            return c + 1;
+        case TO1:
+            if ((ce->delta == EVENCAP && !(c & 1)) ||
+                (ce->delta == ODDCAP && (c & 1)))
+                return c + 1;
+            break;
+        }
+    }
+    return c;
+}
+
+static wint_t
+ref_toupper(wint_t c)
+{
+    const struct caseconv_entry *ce = ref_case(c);
+
+    if (ce) {
+        switch (ce->mode) {
+        case TOUP:
+            return c + ce->delta;
+        case TOBOTH:
+            return c - 1;
+        case TO1:
+            if ((ce->delta == EVENCAP && (c & 1)) ||
+                (ce->delta == ODDCAP && !(c & 1)))
+                return c - 1;
+            break;
+        }
+    }
+    return c;
+}
+
+static const struct {
+    const char  *name;
+    int         (*func)(wint_t);
+    uint16_t    class;
+} funcs[] = {
+    { "iswalnum", iswalnum, CLASS_alnum },
+    { "iswalpha", iswalpha, CLASS_alpha },
+    { "iswblank", iswblank, CLASS_blank },
+    { "iswcntrl", iswcntrl, CLASS_cntrl },
+    { "iswgraph", iswgraph, CLASS_graph },
+    { "iswprint", iswprint, CLASS_print },
+    { "iswpunct", iswpunct, CLASS_punct },
+};
+
+#define NUM_FUNCS       (sizeof(funcs) / sizeof(funcs[0]))
+#define MAX_ERRORS      20
+
+static int errors;
+
+static void
+report(const char *what, wint_t c, long got, long expect)
+{
+    if (errors++ < MAX_ERRORS)
+        printf("%s(U+%04lX): got %#lx expected %#lx\n",
+               what, (unsigned long) c, got, expect);
+}
+
+/* In the C locale nothing outside of ASCII has a class or a case */
+static void
+check(wint_t c, int c_locale)
+{
+    uint16_t cls = 0;
+    wint_t lower = c, upper = c;
+    int is_lower, is_upper;
+    size_t f;
+
+    if (!c_locale || c < 0x80) {
+        cls = ref_class(c);
+        lower = ref_tolower(c);
+        upper = ref_toupper(c);
+    }
+
+    for (f = 0; f < NUM_FUNCS; f++)
+        if ((funcs[f].func(c) != 0) != ((cls & funcs[f].class) != 0))
+            report(funcs[f].name, c, funcs[f].func(c), (cls & funcs[f].class) != 0);
+
+    is_lower = (cls & CLASS_lower) || ((cls & CLASS_case) && upper != c);
+    is_upper = (cls & CLASS_upper) || ((cls & CLASS_case) && lower != c);
+    if ((iswlower(c) != 0) != is_lower)
+        report("iswlower", c, iswlower(c), is_lower);
+    if ((iswupper(c) != 0) != is_upper)
+        report("iswupper", c, iswupper(c), is_upper);
+    if (towlower(c) != lower)
+        report("towlower", c, (long) towlower(c), (long) lower);
+    if (towupper(c) != upper)
+        report("towupper", c, (long) towupper(c), (long) upper);
+}
+
+int
+main(void)
+{
+    static const char *const locales[] = { "C", "C.UTF-8" };
+    unsigned l;
+    wint_t c;
+
+    for (l = 0; l < sizeof(locales) / sizeof(locales[0]); l++) {
+        if (!setlocale(LC_ALL, locales[l])) {
+            printf("setlocale(\"%s\") failed\n", locales[l]);
+            return 1;
+        }
+        for (c = 0; c < MAX_CODE; c++)
+            check(c, l == 0);
+
+        /* Values outside of Unicode have no class or case */
+        if (iswalpha(WEOF) || towlower(WEOF) != WEOF || towupper(WEOF) != WEOF)
+            report("WEOF", WEOF, 1, 0);
+    }
+
+    if (errors)
+        printf("%d errors\n", errors);
+    return errors != 0;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("wide character tables need __MB_CAPABLE, skipping\n");
+    return 77;
+}
+
+#endif
@@ -0,0 +1,229 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check the stdio span write hook: output through a stream with a
+ * write function must match output through a put-only stream,
+ * spans must actually be used, string streams must truncate and
+ * grow correctly and bufio must handle spans larger than its buffer
+ * and line buffering.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__TINY_STDIO) && defined(__STDIO_WRITE_SPAN)
+
+#include <stdio-bufio.h>
+
+#define check(condition, message) do {                  \
+        if (!(condition)) {                             \
+            printf("%s: %s\n", message, #condition);    \
+            exit(1);                                    \
+        }                                               \
+    } while(0)
+
+static char     out[512];
+static size_t   out_len;
+static int      puts_called, writes_called;
+
+static int
+span_put(char c, FILE *f)
+{
+    (void) f;
+    if (out_len < sizeof(out))
+        out[out_len++] = c;
+    puts_called++;
+    return (unsigned char) c;
+}
+
+static int
+span_write(const char *s, size_t len, FILE *f)
+{
+    (void) f;
+    if (len > sizeof(out) - out_len)
+        len = sizeof(out) - out_len;
+    memcpy(out + out_len, s, len);
+    out_len += len;
+    writes_called++;
+    return 0;
+}
+
+static FILE span_file = __FDEV_SETUP_STREAM(span_put, span_write, NULL, NULL, NULL, NULL, _FDEV_SETUP_WRITE);
+static FILE put_file = FDEV_SETUP_STREAM(span_put, NULL, NULL, _FDEV_SETUP_WRITE);
+
+static const char long_string[] =
+    "a span which is longer than the bufio buffer used below, "
+    "so that it is written straight to the device";
+
+static void
+write_all(FILE *f)
+{
+    out_len = 0;
+    puts_called = writes_called = 0;
+    fprintf(f, "literal text %s|%10s|%-8s|%08d|%x|%c\n",
+            "string", "right", "left", 1234, 0xbeefu, 'c');
+    fputs("fputs text\n", f);
+    fwrite("fwrite text\n", 1, 12, f);
+    fwrite(long_string, 2, sizeof(long_string) / 2, f);
+}
+
+static void
+check_streams(void)
+{
+    char        expect[sizeof(out)];
+    size_t      expect_len;
+    int         span_puts, span_writes;
+
+    write_all(&put_file);
+    check(writes_called == 0, "put-only stream called write");
+    memcpy(expect, out, out_len);
+    expect_len = out_len;
+
+    write_all(&span_file);
+    span_puts = puts_called;
+    span_writes = writes_called;
+    check(out_len == expect_len, "span output length differs");
+    check(memcmp(out, expect, out_len) == 0, "span output differs");
+    check(span_writes > 0, "write hook not used");
+    check(span_puts + span_writes < (int) expect_len / 2, "too many calls with spans");
+}
+
+static void
+check_strings(void)
+{
+    char        buf[16];
+    char        *s;
+    int         ret;
+
+    memset(buf, 'x', sizeof(buf));
+    ret = snprintf(buf, 8, "%s %d", "hello world", 42);
+    check(ret == 14, "snprintf return");
+    check(strcmp(buf, "hello w") == 0, "snprintf truncation");
+    check(buf[8] == 'x', "snprintf wrote past the end");
+
+    ret = snprintf(buf, sizeof(buf), "%5s|%-3s|", "ab", "c");
+    check(ret == 10, "snprintf padding return");
+    check(strcmp(buf, "   ab|c  |") == 0, "snprintf padding");
+
+    ret = asprintf(&s, "%s%s%s", long_string, long_string, long_string);
+    check(ret == 3 * (int) strlen(long_string), "asprintf return");
+    check(strncmp(s, long_string, strlen(long_string)) == 0, "asprintf start");
+    check(strcmp(s + 2 * strlen(long_string), long_string) == 0, "asprintf end");
+    free(s);
+}
+
+static char     dev[512];
+static size_t   dev_len;
+static int      dev_writes;
+
+static ssize_t
+dev_write(void *ptr, const void *buf, size_t count)
+{
+    (void) ptr;
+    if (count > sizeof(dev) - dev_len)
+        count = sizeof(dev) - dev_len;
+    memcpy(dev + dev_len, buf, count);
+    dev_len += count;
+    dev_writes++;
+    return count;
+}
+
+static char     bbuf[32];
+
+static struct __file_bufio bfile =
+    FDEV_SETUP_BUFIO_PTR(NULL, bbuf, sizeof(bbuf), NULL, dev_write, NULL, NULL, __SWR, 0);
+
+static struct __file_bufio lfile =
+    FDEV_SETUP_BUFIO_PTR(NULL, bbuf, sizeof(bbuf), NULL, dev_write, NULL, NULL, __SWR, __BLBF);
+
+static void
+check_bufio(void)
+{
+    FILE        *f = &bfile.xfile.cfile.file;
+
+    /* Short spans stay in the buffer */
+    fputs("short", f);
+    check(dev_len == 0, "short span not buffered");
+
+    /* Long spans flush what is buffered and go straight through */
+    fputs(long_string, f);
+    check(dev_len == 5 + strlen(long_string), "long span not written");
+    check(dev_writes == 2, "long span was copied through the buffer");
+    check(memcmp(dev, "short", 5) == 0, "buffered data out of order");
+    check(memcmp(dev + 5, long_string, strlen(long_string)) == 0, "long span data");
+
+    /* Spans filling the buffer flush it */
+    dev_len = 0;
+    fwrite("0123456789012345678901234567890123456789", 1, 31, f);
+    fwrite("0123456789", 1, 10, f);
+    check(dev_len == 32, "full buffer not flushed");
+    fflush(f);
+    check(dev_len == 41, "fflush");
+    check(memcmp(dev, "0123456789012345678901234567890" "0123456789", 41) == 0,
+          "buffer fill data");
+
+    /* Line buffered streams flush a span holding a newline */
+    f = &lfile.xfile.cfile.file;
+    dev_len = 0;
+    fputs("no newline", f);
+    check(dev_len == 0, "line buffered span flushed early");
+    fputs(" newline\n", f);
+    check(dev_len == 19, "line buffered span not flushed");
+    check(memcmp(dev, "no newline newline\n", 19) == 0, "line buffered data");
+}
+
+int
+main(void)
+{
+    check_streams();
+    check_strings();
+    check_bufio();
+    printf("write span test passed\n");
+    return 0;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("skipping write span test\n");
+    return 77;
+}
+
+#endif
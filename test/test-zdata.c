@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check that initialized data, including pointers to code, read-only
+ * data and other initialized data, survives the trip through the
+ * compressed image made by picolibc-compress-data. The same program is
+ * linked with picolibc.ld and picolibc-zdata.ld
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char message_ro[] = "The quick brown fox jumps over the lazy dog";
+
+char message[] = "The quick brown fox jumps over the lazy dog";
+
+const char *pointers[] = { message_ro, message_ro + 4, message };
+
+int (*function)(const char *, ...) = printf;
+
+int sparse[1024] = { [0] = 1, [1] = 2, [100] = 3, [1000] = 4, [1023] = 5 };
+
+#define SQ(i)           ((i) * (i))
+#define SQ4(i)          SQ(i), SQ(i+1), SQ(i+2), SQ(i+3)
+#define SQ16(i)         SQ4(i), SQ4(i+4), SQ4(i+8), SQ4(i+12)
+
+unsigned squares[64] = { SQ16(0), SQ16(16), SQ16(32), SQ16(48) };
+
+#ifdef __THREAD_LOCAL_STORAGE
+__thread int thread_value = 0x12345678;
+#endif
+
+extern char __data_start[], __data_end[];
+extern char __data_lz_source[], __data_lz_end[];
+
+#define check(c) do { if (!(c)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #c); ret = 1; } } while (0)
+
+int
+main(void)
+{
+    int ret = 0;
+    unsigned i;
+
+    check(strcmp(message, message_ro) == 0);
+    check(pointers[0] == message_ro);
+    check(pointers[1] == message_ro + 4);
+    check(pointers[2] == message);
+    check(function == printf);
+    for (i = 0; i < 1024; i++) {
+        int expect = 0;
+        switch (i) {
+        case 0: expect = 1; break;
+        case 1: expect = 2; break;
+        case 100: expect = 3; break;
+        case 1000: expect = 4; break;
+        case 1023: expect = 5; break;
+        }
+        check(sparse[i] == expect);
+    }
+    for (i = 0; i < 64; i++)
+        check(squares[i] == i * i);
+#ifdef __THREAD_LOCAL_STORAGE
+    check(thread_value == 0x12345678);
+#endif
+    printf("data %lu bytes, compressed image %lu bytes\n",
+           (unsigned long) (__data_end - __data_start),
+           (unsigned long) (__data_lz_end - __data_lz_source));
+    return ret;
+}